@@ -3,4 +3,48 @@
 #include "DoodleJump.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogDoodleJump);
+
+DEFINE_STAT(STAT_DoodleCharacterTick);
+DEFINE_STAT(STAT_DoodleMovement);
+DEFINE_STAT(STAT_DoodleMovingPlatforms);
+DEFINE_STAT(STAT_DoodleDartTick);
+DEFINE_STAT(STAT_DoodleDartHit);
+DEFINE_STAT(STAT_DoodleBreakableHit);
+DEFINE_STAT(STAT_DoodleBreakPlatform);
+DEFINE_STAT(STAT_DoodleSignificance);
+DEFINE_STAT(STAT_DoodleTowerGenerate);
+DEFINE_STAT(STAT_DoodleDebris);
+DEFINE_STAT(STAT_DoodleDartProjectiles);
+DEFINE_STAT(STAT_DoodleContacts);
+DEFINE_STAT(STAT_DoodleWorldReset);
+DEFINE_STAT(STAT_DoodleCheckpoint);
+DEFINE_STAT(STAT_DoodleHeightIndex);
+DEFINE_STAT(STAT_DoodleDartTraps);
+DEFINE_STAT(STAT_DoodleLava);
+
+DEFINE_STAT(STAT_DoodleActiveDarts);
+DEFINE_STAT(STAT_DoodleMovingPlatformCount);
+DEFINE_STAT(STAT_DoodleHitEvents);
+DEFINE_STAT(STAT_DoodleContactPairs);
+DEFINE_STAT(STAT_DoodleSignificanceFull);
+DEFINE_STAT(STAT_DoodleSignificanceReduced);
+DEFINE_STAT(STAT_DoodleSignificanceCulled);
+DEFINE_STAT(STAT_DoodleTicksSkipped);
+DEFINE_STAT(STAT_DoodleTowerChunks);
+DEFINE_STAT(STAT_DoodleTowerLiveActors);
+DEFINE_STAT(STAT_DoodleTowerPooledActors);
+DEFINE_STAT(STAT_DoodleDebrisSimulating);
+DEFINE_STAT(STAT_DoodleDebrisRetired);
+DEFINE_STAT(STAT_DoodleCheckpointBytes);
+DEFINE_STAT(STAT_DoodleHeightIndexEntries);
+DEFINE_STAT(STAT_DoodleHeightIndexMoving);
+DEFINE_STAT(STAT_DoodleDartTrapCount);
+DEFINE_STAT(STAT_DoodleDartTrapShots);
+DEFINE_STAT(STAT_DoodleDartTrapSkipped);
+
+DEFINE_STAT(STAT_DoodleBrokenPlatforms);
+
+CSV_DEFINE_CATEGORY_MODULE(DOODLEJUMP_API, DoodleJump, true);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, DoodleJump, "DoodleJump" );
@@ -3,4 +3,68 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Logging/LogMacros.h"
 
+// Everything above the compile-time verbosity is stripped from the binary, so shipping builds keep warnings and errors only
+#ifndef DOODLE_LOG_COMPILE_VERBOSITY
+#if UE_BUILD_SHIPPING
+#define DOODLE_LOG_COMPILE_VERBOSITY Warning
+#else
+#define DOODLE_LOG_COMPILE_VERBOSITY All
+#endif
+#endif
+
+DOODLEJUMP_API DECLARE_LOG_CATEGORY_EXTERN(LogDoodleJump, Log, DOODLE_LOG_COMPILE_VERBOSITY);
+
+// Object channel of the DoodleHazard collision profile (Config/DefaultEngine.ini) - breakable platforms, launchpads, freeze traps and darts
+#define ECC_DoodleHazard ECC_GameTraceChannel1
+
+// Gameplay hot paths - "stat DoodleJump" in game, DoodleJump track in Insights
+DECLARE_STATS_GROUP(TEXT("DoodleJump"), STATGROUP_DoodleJump, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Character Tick"), STAT_DoodleCharacterTick, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Doodle Movement"), STAT_DoodleMovement, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Moving Platforms Update"), STAT_DoodleMovingPlatforms, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dart Tick"), STAT_DoodleDartTick, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dart Hit"), STAT_DoodleDartHit, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Breakable Platform Hit"), STAT_DoodleBreakableHit, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Break Platform"), STAT_DoodleBreakPlatform, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Significance Update"), STAT_DoodleSignificance, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tower Generation"), STAT_DoodleTowerGenerate, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Debris Update"), STAT_DoodleDebris, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dart Projectiles"), STAT_DoodleDartProjectiles, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Contact Dispatch"), STAT_DoodleContacts, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("World Reset"), STAT_DoodleWorldReset, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Checkpoint Save/Restore"), STAT_DoodleCheckpoint, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Height Index Update"), STAT_DoodleHeightIndex, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dart Trap Scheduler"), STAT_DoodleDartTraps, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rising Lava"), STAT_DoodleLava, STATGROUP_DoodleJump, DOODLEJUMP_API);
+
+// Per-frame counts, reset every frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Active Darts"), STAT_DoodleActiveDarts, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Moving Platforms"), STAT_DoodleMovingPlatformCount, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hit Events"), STAT_DoodleHitEvents, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Contact Pairs"), STAT_DoodleContactPairs, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Significance Full Rate"), STAT_DoodleSignificanceFull, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Significance Reduced Rate"), STAT_DoodleSignificanceReduced, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Significance Culled"), STAT_DoodleSignificanceCulled, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Ticks Skipped"), STAT_DoodleTicksSkipped, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Tower Chunks"), STAT_DoodleTowerChunks, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Tower Live Platforms"), STAT_DoodleTowerLiveActors, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Tower Pooled Platforms"), STAT_DoodleTowerPooledActors, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Debris Simulating"), STAT_DoodleDebrisSimulating, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Debris Retired"), STAT_DoodleDebrisRetired, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Checkpoint Bytes"), STAT_DoodleCheckpointBytes, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Height Index Entries"), STAT_DoodleHeightIndexEntries, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Height Index Moving"), STAT_DoodleHeightIndexMoving, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dart Traps"), STAT_DoodleDartTrapCount, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dart Trap Shots"), STAT_DoodleDartTrapShots, STATGROUP_DoodleJump, DOODLEJUMP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dart Trap Shots Skipped"), STAT_DoodleDartTrapSkipped, STATGROUP_DoodleJump, DOODLEJUMP_API);
+
+// Running totals
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Broken Platforms"), STAT_DoodleBrokenPlatforms, STATGROUP_DoodleJump, DOODLEJUMP_API);
+
+// Same numbers in CSV captures (-csvCaptureFrames=N, or -BenchCsv in benchmark runs)
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(DOODLEJUMP_API, DoodleJump);
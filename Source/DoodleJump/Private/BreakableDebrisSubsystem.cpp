@@ -0,0 +1,127 @@
+#include "BreakableDebrisSubsystem.h"
+#include "BreakablePlatform.h"
+#include "DoodleJump.h"
+#include "DoodleSignificanceSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/WorldSettings.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+
+UBreakableDebrisSubsystem::UBreakableDebrisSubsystem()
+{
+	MaxSimulatingDebris = 8;
+	MaxSimulationTime = 5.0f;
+	KillDistanceBelowPlayer = 2000.0f;
+	OffscreenTimeout = 1.0f;
+
+	NumRetiredThisFrame = 0;
+}
+
+bool UBreakableDebrisSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UBreakableDebrisSubsystem::Deinitialize()
+{
+	Debris.Empty();
+	StartTimes.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UBreakableDebrisSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBreakableDebrisSubsystem, STATGROUP_Tickables);
+}
+
+void UBreakableDebrisSubsystem::AddDebris(ABreakablePlatform* Platform)
+{
+	if (!Platform || Debris.Contains(Platform))
+	{
+		return;
+	}
+
+	while (Debris.Num() > 0 && Debris.Num() >= MaxSimulatingDebris)
+	{
+		RetireAt(0);
+	}
+
+	Debris.Add(Platform);
+	StartTimes.Add(GetWorld()->GetTimeSeconds());
+}
+
+void UBreakableDebrisSubsystem::RemoveDebris(ABreakablePlatform* Platform)
+{
+	const int32 Index = Debris.Find(Platform);
+	if (Index != INDEX_NONE)
+	{
+		Debris.RemoveAt(Index, EAllowShrinking::No);
+		StartTimes.RemoveAt(Index, EAllowShrinking::No);
+	}
+}
+
+void UBreakableDebrisSubsystem::RetireAt(int32 Index)
+{
+	ABreakablePlatform* Platform = Debris[Index];
+	Debris.RemoveAt(Index, EAllowShrinking::No);
+	StartTimes.RemoveAt(Index, EAllowShrinking::No);
+
+	if (IsValid(Platform))
+	{
+		Platform->RetireDebris();
+		NumRetiredThisFrame++;
+	}
+}
+
+void UBreakableDebrisSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_DoodleDebris);
+
+	Super::Tick(DeltaTime);
+
+	UWorld* World = GetWorld();
+	const double Time = World->GetTimeSeconds();
+
+	float KillZ = World->GetWorldSettings() ? World->GetWorldSettings()->KillZ : -UE_BIG_NUMBER;
+	if (const APawn* Player = UGameplayStatics::GetPlayerPawn(World, 0))
+	{
+		KillZ = FMath::Max(KillZ, static_cast<float>(Player->GetActorLocation().Z) - KillDistanceBelowPlayer);
+	}
+	if (const UDoodleSignificanceSubsystem* Significance = World->GetSubsystem<UDoodleSignificanceSubsystem>())
+	{
+		KillZ = FMath::Max(KillZ, static_cast<float>(Significance->GetCullFloor()));
+	}
+
+	// Nothing is ever rendered in -nullrhi runs, so visibility only counts when we can render.
+	// Fixed-step runs must not depend on what happened to be rendered either.
+	const bool bCheckVisibility = FApp::CanEverRender() && !FApp::UseFixedTimeStep();
+
+	for (int32 Index = Debris.Num() - 1; Index >= 0; --Index)
+	{
+		const ABreakablePlatform* Platform = Debris[Index];
+		if (!IsValid(Platform))
+		{
+			Debris.RemoveAt(Index, EAllowShrinking::No);
+			StartTimes.RemoveAt(Index, EAllowShrinking::No);
+			continue;
+		}
+
+		const double SimulatedTime = Time - StartTimes[Index];
+		const bool bBelowKillZ = Platform->GetActorLocation().Z < KillZ;
+		const bool bExpired = SimulatedTime >= MaxSimulationTime;
+		const bool bOffscreen = bCheckVisibility && SimulatedTime >= OffscreenTimeout && !Platform->WasRecentlyRendered(OffscreenTimeout);
+
+		if (bBelowKillZ || bExpired || bOffscreen)
+		{
+			RetireAt(Index);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_DoodleDebrisSimulating, Debris.Num());
+	SET_DWORD_STAT(STAT_DoodleDebrisRetired, NumRetiredThisFrame);
+	CSV_CUSTOM_STAT(DoodleJump, DebrisSimulating, Debris.Num(), ECsvCustomStatOp::Set);
+	NumRetiredThisFrame = 0;
+}
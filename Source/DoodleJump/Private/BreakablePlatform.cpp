@@ -1,19 +1,21 @@
 #include "BreakablePlatform.h"
 #include "Components/BoxComponent.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
 #include "DoodleCharacter.h"
-#include "Animation/AnimSequenceBase.h"
-#include "Animation/AnimInstance.h"
+#include "DoodleContactSubsystem.h"
+#include "DoodleJump.h"
+#include "BreakableDebrisSubsystem.h"
+#include "DoodlePlatformMeshSwap.h"
+#include "DoodlePlatformTuning.h"
+#include "DoodleTrace.h"
 #include "TimerManager.h"
 
 ABreakablePlatform::ABreakablePlatform()
 {
-	PrimaryActorTick.bCanEverTick = false;
-
 	PlatformMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("PlatformMesh"));
 	RootComponent = PlatformMesh;
-	PlatformMesh->SetCollisionProfileName(TEXT("BlockAll"));
-	PlatformMesh->SetNotifyRigidBodyCollision(true);
+	PlatformMesh->SetCollisionProfileName(TEXT("DoodleHazard"));
 	PlatformMesh->SetSimulatePhysics(false);
 	PlatformMesh->SetEnableGravity(false);
 
@@ -22,136 +24,216 @@ ABreakablePlatform::ABreakablePlatform()
 	CollisionBox->SetBoxExtent(FVector(60.0f, 60.0f, 15.0f));
 	CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
+	IdleMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("IdleMesh"));
+	IdleMesh->SetupAttachment(PlatformMesh);
+	IdleMesh->SetCollisionProfileName(TEXT("DoodleHazard"));
+	IdleMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
 	BreakDelay = 0.1f;
 	bIsBroken = false;
 	BreakAnimation = nullptr;
 	bUsePhysics = false;
+	InitialCollisionEnabled = ECollisionEnabled::QueryAndPhysics;
+	InitialCollisionProfile = NAME_None;
+	bUseIdleMesh = false;
+}
+
+void ABreakablePlatform::ApplyTuning(const UDoodlePlatformTuning& InTuning)
+{
+	BreakDelay = InTuning.BreakDelay;
+	bUsePhysics = InTuning.bUseBreakPhysics;
 }
 
 void ABreakablePlatform::BeginPlay()
 {
 	Super::BeginPlay();
 
-	UE_LOG(LogTemp, Warning, TEXT("=== BreakablePlatform BeginPlay START ==="));
-	UE_LOG(LogTemp, Warning, TEXT("PlatformMesh valid: %s"), PlatformMesh ? TEXT("YES") : TEXT("NO"));
+	InitialTransform = GetActorTransform();
+	InitialCollisionEnabled = PlatformMesh ? PlatformMesh->GetCollisionEnabled() : ECollisionEnabled::QueryAndPhysics;
+	InitialCollisionProfile = PlatformMesh ? PlatformMesh->GetCollisionProfileName() : NAME_None;
+
+	bUseIdleMesh = PlatformMesh && FDoodlePlatformMeshSwap::CanUse(IdleMesh);
+	if (bUseIdleMesh)
+	{
+		FDoodlePlatformMeshSwap::SetIdle(PlatformMesh, IdleMesh, InitialCollisionEnabled);
+	}
+	else if (IdleMesh)
+	{
+		IdleMesh->SetVisibility(false);
+	}
 
 	if (PlatformMesh)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PlatformMesh Collision Enabled: %d"), (int32)PlatformMesh->GetCollisionEnabled());
-		UE_LOG(LogTemp, Warning, TEXT("PlatformMesh Profile Name: %s"), *PlatformMesh->GetCollisionProfileName().ToString());
-		UE_LOG(LogTemp, Warning, TEXT("PlatformMesh Notify Rigid Body Collision: %s"), PlatformMesh->BodyInstance.bNotifyRigidBodyCollision ? TEXT("YES") : TEXT("NO"));
+		RegisterContactComponent(PlatformMesh);
+		if (bUseIdleMesh)
+		{
+			RegisterContactComponent(IdleMesh);
+		}
 
-		PlatformMesh->OnComponentHit.AddDynamic(this, &ABreakablePlatform::OnPlatformHit);
-		UE_LOG(LogTemp, Warning, TEXT("Hit event bound successfully"));
+		UE_LOG(LogDoodleJump, Verbose, TEXT("BreakablePlatform '%s': collision %d, profile '%s'"), *GetName(),
+			(int32)PlatformMesh->GetCollisionEnabled(), *PlatformMesh->GetCollisionProfileName().ToString());
+	}
+	else
+	{
+		UE_LOG(LogDoodleJump, Warning, TEXT("BreakablePlatform '%s': No PlatformMesh!"), *GetName());
 	}
-
-	UE_LOG(LogTemp, Warning, TEXT("=== BreakablePlatform BeginPlay END ==="));
 }
 
-void ABreakablePlatform::OnPlatformHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+void ABreakablePlatform::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	UE_LOG(LogTemp, Warning, TEXT("OnPlatformHit triggered! OtherActor: %s"), OtherActor ? *OtherActor->GetName() : TEXT("NULL"));
-
 	if (bIsBroken)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Platform already broken, ignoring hit"));
-		return;
+		DEC_DWORD_STAT(STAT_DoodleBrokenPlatforms);
 	}
 
-	ADoodleCharacter* Character = Cast<ADoodleCharacter>(OtherActor);
-	if (!Character)
+	if (UBreakableDebrisSubsystem* DebrisSubsystem = GetWorld()->GetSubsystem<UBreakableDebrisSubsystem>())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Hit actor is not DoodleCharacter, ignoring"));
-		return;
+		DebrisSubsystem->RemoveDebris(this);
 	}
 
-	FVector HitNormal = Hit.Normal;
-	UE_LOG(LogTemp, Warning, TEXT("Hit Normal: %s (Z: %f)"), *HitNormal.ToString(), HitNormal.Z);
+	Super::EndPlay(EndPlayReason);
+}
 
-	if (HitNormal.Z > 0.7f || HitNormal.Z < -0.7f)
+void ABreakablePlatform::HandleContact(const FDoodleContact& Contact)
+{
+	SCOPE_CYCLE_COUNTER(STAT_DoodleBreakableHit);
+	CSV_SCOPED_TIMING_STAT(DoodleJump, BreakableHit);
+
+	if (bIsBroken)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Valid hit direction, breaking platform!"));
-		BreakPlatform();
+		return;
 	}
-	else
+
+	const bool bValidHit = Contact.Side != EDoodleContactSide::Side;
+	DOODLE_TRACE(PlatformHit, this, Contact.Character, Contact.Normal.X, Contact.Normal.Y, Contact.Normal.Z, bValidHit ? 1.0f : 0.0f);
+
+	if (bValidHit)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Invalid hit direction, ignoring"));
+		BreakPlatform();
 	}
 }
 
 void ABreakablePlatform::BreakPlatform()
 {
+	SCOPE_CYCLE_COUNTER(STAT_DoodleBreakPlatform);
+	CSV_SCOPED_TIMING_STAT(DoodleJump, BreakPlatform);
+	INC_DWORD_STAT(STAT_DoodleBrokenPlatforms);
+	CSV_CUSTOM_STAT(DoodleJump, PlatformBreaks, 1, ECsvCustomStatOp::Accumulate);
+
 	bIsBroken = true;
-	UE_LOG(LogTemp, Warning, TEXT("BreakPlatform called! Delay: %f"), BreakDelay);
+	DOODLE_TRACE(PlatformBreak, this, nullptr, BreakDelay);
 
 	GetWorld()->GetTimerManager().SetTimer(BreakTimerHandle, [this]()
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Break timer fired!"));
+		// Wake the skeletal mesh for the animation and the fall
+		if (bUseIdleMesh)
+		{
+			FDoodlePlatformMeshSwap::SetAnimated(PlatformMesh, IdleMesh, InitialCollisionEnabled);
+		}
 
 		if (BreakAnimation)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("BreakAnimation assigned: %s"), *BreakAnimation->GetName());
-
-			if (UAnimInstance* AnimInstance = PlatformMesh->GetAnimInstance())
-			{
-				UE_LOG(LogTemp, Warning, TEXT("AnimInstance found: %s"), *AnimInstance->GetClass()->GetName());
-				UE_LOG(LogTemp, Warning, TEXT("Playing animation via AnimInstance"));
-				AnimInstance->Montage_Play(Cast<UAnimMontage>(BreakAnimation), 1.0f);
-			}
-			else
-			{
-				UE_LOG(LogTemp, Warning, TEXT("No AnimInstance, playing animation directly on mesh"));
-				PlatformMesh->PlayAnimation(BreakAnimation, false);
-			}
-
-			float AnimDuration = BreakAnimation->GetPlayLength();
-			UE_LOG(LogTemp, Warning, TEXT("Animation duration: %f seconds"), AnimDuration);
+			const float AnimDuration = FDoodlePlatformMeshSwap::PlayAnimation(PlatformMesh, BreakAnimation);
 
-			GetWorld()->GetTimerManager().SetTimer(PhysicsTimerHandle, [this]()
+			GetWorld()->GetTimerManager().SetTimer(PhysicsTimerHandle, [this, AnimDuration]()
 			{
-				UE_LOG(LogTemp, Warning, TEXT("Animation finished! Enabling gravity (bUsePhysics: %s)"), bUsePhysics ? TEXT("YES") : TEXT("NO"));
-
-				if (bUsePhysics)
-				{
-					UE_LOG(LogTemp, Warning, TEXT("Enabling physics simulation"));
-					PlatformMesh->SetSimulatePhysics(true);
-					PlatformMesh->SetCollisionEnabled(ECollisionEnabled::PhysicsOnly);
-					PlatformMesh->SetEnableGravity(true);
-				}
-				else
-				{
-					UE_LOG(LogTemp, Warning, TEXT("Enabling gravity only (no physics)"));
-					// For gravity-only, we need physics simulation to apply gravity
-					PlatformMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-					PlatformMesh->SetSimulatePhysics(true);
-					PlatformMesh->SetEnableGravity(true);
-				}
-
-				UE_LOG(LogTemp, Warning, TEXT("Gravity enabled: %s"), PlatformMesh->IsGravityEnabled() ? TEXT("YES") : TEXT("NO"));
-				UE_LOG(LogTemp, Warning, TEXT("Simulating physics: %s"), PlatformMesh->IsSimulatingPhysics() ? TEXT("YES") : TEXT("NO"));
+				DOODLE_TRACE(PlatformFall, this, nullptr, bUsePhysics ? 1.0f : 0.0f, AnimDuration);
+				StartFalling();
 			}, AnimDuration, false);
 		}
 		else
 		{
-			UE_LOG(LogTemp, Warning, TEXT("No BreakAnimation assigned! Just enabling gravity"));
+			DOODLE_TRACE(PlatformFall, this, nullptr, bUsePhysics ? 1.0f : 0.0f);
+			StartFalling();
+		}
+	}, BreakDelay, false);
+}
 
-			if (bUsePhysics)
-			{
-				PlatformMesh->SetSimulatePhysics(true);
-				PlatformMesh->SetCollisionEnabled(ECollisionEnabled::PhysicsOnly);
-			}
-			else
-			{
-				// For gravity-only, we need physics simulation to apply gravity
-				PlatformMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-				PlatformMesh->SetSimulatePhysics(true);
-			}
+void ABreakablePlatform::StartFalling()
+{
+	if (bUsePhysics)
+	{
+		// DoodleHazard only blocks pawns and traces - debris that should land on the level needs a physics profile
+		PlatformMesh->SetCollisionProfileName(TEXT("PhysicsActor"));
+		PlatformMesh->SetSimulatePhysics(true);
+		PlatformMesh->SetCollisionEnabled(ECollisionEnabled::PhysicsOnly);
+	}
+	else
+	{
+		// For gravity-only, we need physics simulation to apply gravity
+		PlatformMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		PlatformMesh->SetSimulatePhysics(true);
+	}
 
-			PlatformMesh->SetEnableGravity(true);
+	PlatformMesh->SetEnableGravity(true);
 
-			UE_LOG(LogTemp, Warning, TEXT("Gravity enabled: %s"), PlatformMesh->IsGravityEnabled() ? TEXT("YES") : TEXT("NO"));
-			UE_LOG(LogTemp, Warning, TEXT("Simulating physics: %s"), PlatformMesh->IsSimulatingPhysics() ? TEXT("YES") : TEXT("NO"));
-		}
-	}, BreakDelay, false);
+	RegisterDebris();
+}
+
+void ABreakablePlatform::RegisterDebris()
+{
+	if (UBreakableDebrisSubsystem* DebrisSubsystem = GetWorld()->GetSubsystem<UBreakableDebrisSubsystem>())
+	{
+		DebrisSubsystem->AddDebris(this);
+	}
+}
+
+void ABreakablePlatform::RetireDebris()
+{
+	PlatformMesh->SetSimulatePhysics(false);
+	PlatformMesh->SetEnableGravity(false);
+	PlatformMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetActorHiddenInGame(true);
+}
+
+void ABreakablePlatform::RestoreBroken()
+{
+	ResetPlatform();
+
+	INC_DWORD_STAT(STAT_DoodleBrokenPlatforms);
+	bIsBroken = true;
+
+	if (bUseIdleMesh)
+	{
+		IdleMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
+	RetireDebris();
+}
+
+void ABreakablePlatform::ResetPlatform()
+{
+	GetWorldTimerManager().ClearTimer(BreakTimerHandle);
+	GetWorldTimerManager().ClearTimer(PhysicsTimerHandle);
+
+	if (UBreakableDebrisSubsystem* DebrisSubsystem = GetWorld()->GetSubsystem<UBreakableDebrisSubsystem>())
+	{
+		DebrisSubsystem->RemoveDebris(this);
+	}
+
+	if (bIsBroken)
+	{
+		DEC_DWORD_STAT(STAT_DoodleBrokenPlatforms);
+	}
+	bIsBroken = false;
+
+	// Back to the unbroken pose
+	FDoodlePlatformMeshSwap::StopAnimation(PlatformMesh);
+
+	PlatformMesh->SetSimulatePhysics(false);
+	PlatformMesh->SetEnableGravity(false);
+	if (InitialCollisionProfile != NAME_None)
+	{
+		PlatformMesh->SetCollisionProfileName(InitialCollisionProfile);
+	}
+	if (bUseIdleMesh)
+	{
+		FDoodlePlatformMeshSwap::SetIdle(PlatformMesh, IdleMesh, InitialCollisionEnabled);
+	}
+	else
+	{
+		PlatformMesh->SetCollisionEnabled(InitialCollisionEnabled);
+	}
+	SetActorTransform(InitialTransform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
 }
 
@@ -4,6 +4,14 @@
 #include "Components/StaticMeshComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "DoodleCharacter.h"
+#include "DoodleContactSubsystem.h"
+#include "DartPoolSubsystem.h"
+#include "DoodleHeightIndexSubsystem.h"
+#include "DoodleSignificanceSubsystem.h"
+#include "DoodleBenchmark.h"
+#include "DoodleJump.h"
+#include "DoodleTrace.h"
+#include "DoodleWorldResetSubsystem.h"
 
 ADart::ADart()
 {
@@ -25,9 +33,10 @@ ADart::ADart()
 	CollisionCapsule->SetCapsuleHalfHeight(50.0f);
 	CollisionCapsule->SetCapsuleRadius(10.0f);
 
-	// Enable collision but DISABLE physics simulation to prevent momentum transfer
+	// Enable collision but DISABLE physics simulation to prevent momentum transfer.
+	// Hits come from the character's movement sweeps, which are dispatched without rigid body notifications.
+	CollisionCapsule->SetCollisionProfileName(TEXT("DoodleHazard"));
 	CollisionCapsule->SetCollisionEnabled(ECollisionEnabled::QueryOnly);  // QueryOnly = no physics simulation
-	CollisionCapsule->SetNotifyRigidBodyCollision(true); // Enable hit events
 
 	// CRITICAL: Disable simulation to prevent the dart from transferring velocity to the player
 	CollisionCapsule->SetSimulatePhysics(false);
@@ -38,6 +47,11 @@ ADart::ADart()
 	KnockbackForce = 1000.0f;
 	DotProductThreshold = 0.5f;
 	Lifetime = 10.0f; // 10 seconds by default
+
+	bIsPooled = false;
+	bIsInPool = false;
+	ActiveTime = 0.0f;
+	HeightIndexHandle = INDEX_NONE;
 }
 
 void ADart::BeginPlay()
@@ -47,18 +61,70 @@ void ADart::BeginPlay()
 	// Bind hit event
 	if (CollisionCapsule)
 	{
-		CollisionCapsule->OnComponentHit.AddDynamic(this, &ADart::OnCapsuleHit);
-		UE_LOG(LogTemp, Log, TEXT("Dart '%s' initialized. Speed: %.2f, Knockback Force: %.2f, Lifetime: %.2f seconds"), *GetName(), DartSpeed, KnockbackForce, Lifetime);
+		if (UDoodleContactSubsystem* Contacts = GetWorld()->GetSubsystem<UDoodleContactSubsystem>())
+		{
+			Contacts->RegisterHazard(CollisionCapsule, FDoodleContactDelegate::CreateUObject(this, &ADart::HandleContact));
+		}
+		UE_LOG(LogDoodleJump, Verbose, TEXT("Dart '%s' initialized. Speed: %.2f, Knockback Force: %.2f, Lifetime: %.2f seconds"), *GetName(), DartSpeed, KnockbackForce, Lifetime);
+	}
+
+	// Lifetime is tracked in Tick so pooled darts can be recycled instead of destroyed
+	ActiveTime = 0.0f;
+
+	// Pre-warmed darts may begin play after they were already parked in the pool
+	if (bIsInPool)
+	{
+		DeactivateToPool();
+	}
+	else
+	{
+		RegisterInFlight();
 	}
 
-	// Set lifetime for the dart - it will auto-destroy after this time
-	SetLifeSpan(Lifetime);
+	// Pooled darts are released by the pool on a world reset, darts spawned directly go away
+	if (!bIsPooled)
+	{
+		if (UDoodleWorldResetSubsystem* Reset = GetWorld()->GetSubsystem<UDoodleWorldResetSubsystem>())
+		{
+			Reset->RegisterResettable(this, FSimpleDelegate::CreateUObject(this, &ADart::Expire));
+		}
+	}
+}
+
+void ADart::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterInFlight();
+
+	if (UDoodleContactSubsystem* Contacts = GetWorld()->GetSubsystem<UDoodleContactSubsystem>())
+	{
+		Contacts->UnregisterHazard(CollisionCapsule);
+	}
+
+	if (UDoodleWorldResetSubsystem* Reset = GetWorld()->GetSubsystem<UDoodleWorldResetSubsystem>())
+	{
+		Reset->UnregisterResettable(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ADart::Tick(float DeltaTime)
 {
+	DOODLE_BENCHMARK_TICK_SCOPE("ADart");
+	SCOPE_CYCLE_COUNTER(STAT_DoodleDartTick);
+	CSV_SCOPED_TIMING_STAT(DoodleJump, DartTick);
+	INC_DWORD_STAT(STAT_DoodleActiveDarts);
+	CSV_CUSTOM_STAT(DoodleJump, ActiveDarts, 1, ECsvCustomStatOp::Accumulate);
+
 	Super::Tick(DeltaTime);
 
+	ActiveTime += DeltaTime;
+	if (ActiveTime >= Lifetime)
+	{
+		Expire();
+		return;
+	}
+
 	// Move dart in local Y axis direction (right vector corresponds to Y axis)
 	FVector LocalYDirection = GetActorRightVector();
 	FVector CurrentLocation = GetActorLocation();
@@ -66,45 +132,108 @@ void ADart::Tick(float DeltaTime)
 	SetActorLocation(NewLocation);
 }
 
-void ADart::OnCapsuleHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+void ADart::ActivateFromPool(const FTransform& SpawnTransform)
+{
+	bIsInPool = false;
+	ActiveTime = 0.0f;
+
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	RegisterInFlight();
+}
+
+void ADart::DeactivateToPool()
 {
-	// Check if we hit the player
-	ADoodleCharacter* HitCharacter = Cast<ADoodleCharacter>(OtherActor);
-	if (!HitCharacter)
+	bIsInPool = true;
+
+	UnregisterInFlight();
+
+	SetActorTickEnabled(false);
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+}
+
+void ADart::Expire()
+{
+	if (bIsPooled)
 	{
-		return; // Not the player, ignore
+		if (UDartPoolSubsystem* DartPool = GetWorld()->GetSubsystem<UDartPoolSubsystem>())
+		{
+			DartPool->ReleaseDart(this);
+			return;
+		}
 	}
 
-	// Get dart velocity direction (using actor's local Y axis = right vector)
-	FVector DartVelocity = GetActorRightVector();
+	Destroy();
+}
+
+void ADart::RegisterInFlight()
+{
+	if (UDoodleSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UDoodleSignificanceSubsystem>())
+	{
+		Significance->RegisterActor(this, FSimpleDelegate::CreateUObject(this, &ADart::Expire));
+	}
+
+	if (UDoodleHeightIndexSubsystem* HeightIndex = GetWorld()->GetSubsystem<UDoodleHeightIndexSubsystem>())
+	{
+		if (HeightIndexHandle == INDEX_NONE)
+		{
+			HeightIndexHandle = HeightIndex->AddActor(this, DHC_Dart, true);
+		}
+	}
+}
+
+void ADart::UnregisterInFlight()
+{
+	if (UWorld* World = GetWorld())
+	{
+		if (UDoodleSignificanceSubsystem* Significance = World->GetSubsystem<UDoodleSignificanceSubsystem>())
+		{
+			Significance->UnregisterActor(this);
+		}
+
+		if (UDoodleHeightIndexSubsystem* HeightIndex = World->GetSubsystem<UDoodleHeightIndexSubsystem>())
+		{
+			HeightIndex->Remove(HeightIndexHandle);
+		}
+	}
+}
+
+void ADart::HandleContact(const FDoodleContact& Contact)
+{
+	SCOPE_CYCLE_COUNTER(STAT_DoodleDartHit);
+	CSV_SCOPED_TIMING_STAT(DoodleJump, DartHit);
+
+	// Expired earlier this frame, after the contact was recorded
+	if (bIsInPool)
+	{
+		return;
+	}
 
-	// Calculate direction from dart to player
-	FVector DartLocation = GetActorLocation();
-	FVector PlayerLocation = HitCharacter->GetActorLocation();
-	FVector ToPlayerDirection = (PlayerLocation - DartLocation).GetSafeNormal();
+	ADoodleCharacter* HitCharacter = Contact.Character;
+
+	// Get dart velocity direction (using actor's local Y axis = right vector)
+	const FVector DartVelocity = GetActorRightVector();
 
 	// Calculate dot product to check if dart was flying TOWARDS player
-	float DotProduct = FVector::DotProduct(DartVelocity, ToPlayerDirection);
+	const float DotProduct = FVector::DotProduct(DartVelocity, Contact.ToCharacter);
 
-	UE_LOG(LogTemp, Warning, TEXT("==== DART HIT PLAYER ===="));
-	UE_LOG(LogTemp, Warning, TEXT("Dart Velocity Direction: %s"), *DartVelocity.ToString());
-	UE_LOG(LogTemp, Warning, TEXT("Direction To Player: %s"), *ToPlayerDirection.ToString());
-	UE_LOG(LogTemp, Warning, TEXT("Dot Product: %.3f (Threshold: %.3f)"), DotProduct, DotProductThreshold);
+	DOODLE_TRACE(DartHit, this, HitCharacter, DotProduct, DotProductThreshold, DotProduct > DotProductThreshold ? 1.0f : 0.0f);
 
 	// If dot product > threshold, dart was flying INTO player -> apply knockback
 	if (DotProduct > DotProductThreshold)
 	{
-		UE_LOG(LogTemp, Warning, TEXT(">>> DART HIT PLAYER - APPLYING KNOCKBACK! <<<"));
-
 		// Apply knockback in the direction of dart's movement
 		HitCharacter->ApplyKnockback(DartVelocity, KnockbackForce);
 
-		// Destroy the dart
-		Destroy();
+		// Return the dart to the pool (or destroy it if it was spawned directly)
+		Expire();
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT(">>> PLAYER LANDED ON DART - NO KNOCKBACK (acts as platform) <<<"));
 		// Player landed on dart or dart hit from wrong angle - act as static platform
 		// No velocity inheritance possible since movement is pure input-based (no velocity tracking)
 	}
@@ -0,0 +1,196 @@
+#include "DartPoolSubsystem.h"
+#include "Dart.h"
+#include "DoodleJump.h"
+#include "Engine/World.h"
+
+UDartPoolSubsystem::UDartPoolSubsystem()
+{
+	PrewarmCount = 32;
+	TotalActiveCount = 0;
+	TotalHighWaterMark = 0;
+}
+
+bool UDartPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDartPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (const FSoftClassPath& ClassPath : PrewarmDartClasses)
+	{
+		if (UClass* DartClass = ClassPath.TryLoadClass<ADart>())
+		{
+			PrewarmPool(DartClass, PrewarmCount);
+		}
+		else
+		{
+			UE_LOG(LogDoodleJump, Warning, TEXT("DartPool: Could not load dart class '%s'"), *ClassPath.ToString());
+		}
+	}
+}
+
+void UDartPoolSubsystem::Deinitialize()
+{
+	for (const TPair<UClass*, FDartPoolBucket>& Pair : Buckets)
+	{
+		const FDartPoolStats& Stats = Pair.Value.Stats;
+		UE_LOG(LogDoodleJump, Log, TEXT("DartPool '%s': Pooled: %d, High-water mark: %d, Misses: %d"),
+			*GetNameSafe(Pair.Key), Stats.PooledCount, Stats.HighWaterMark, Stats.Misses);
+	}
+
+	UE_LOG(LogDoodleJump, Log, TEXT("DartPool: High-water mark over every class: %d"), TotalHighWaterMark);
+
+	Buckets.Empty();
+	TotalActiveCount = 0;
+	TotalHighWaterMark = 0;
+
+	Super::Deinitialize();
+}
+
+void UDartPoolSubsystem::PrewarmPool(TSubclassOf<ADart> DartClass, int32 Count)
+{
+	if (!DartClass || Count <= 0)
+	{
+		return;
+	}
+
+	FDartPoolBucket& Bucket = Buckets.FindOrAdd(DartClass);
+	Bucket.AllDarts.Reserve(Bucket.AllDarts.Num() + Count);
+	Bucket.FreeDarts.Reserve(Bucket.AllDarts.Num() + Count);
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		if (ADart* Dart = SpawnPooledDart(DartClass, Bucket))
+		{
+			Dart->DeactivateToPool();
+			Bucket.FreeDarts.Add(Dart);
+		}
+	}
+}
+
+ADart* UDartPoolSubsystem::AcquireDart(TSubclassOf<ADart> DartClass, const FTransform& SpawnTransform, float FlightTime)
+{
+	if (!DartClass || (FlightTime > 0.0f && FlightTime >= DartClass->GetDefaultObject<ADart>()->Lifetime))
+	{
+		return nullptr;
+	}
+
+	FDartPoolBucket& Bucket = Buckets.FindOrAdd(DartClass);
+
+	ADart* Dart = nullptr;
+	while (!Dart && Bucket.FreeDarts.Num() > 0)
+	{
+		Dart = Bucket.FreeDarts.Pop(EAllowShrinking::No);
+		if (!IsValid(Dart))
+		{
+			Dart = nullptr;
+		}
+	}
+
+	if (!Dart)
+	{
+		Dart = SpawnPooledDart(DartClass, Bucket);
+		if (!Dart)
+		{
+			return nullptr;
+		}
+
+		// Keep enough room so releasing every dart never reallocates
+		Bucket.FreeDarts.Reserve(Bucket.AllDarts.Num());
+		Bucket.Stats.Misses++;
+	}
+
+	Bucket.Stats.ActiveCount++;
+	Bucket.Stats.HighWaterMark = FMath::Max(Bucket.Stats.HighWaterMark, Bucket.Stats.ActiveCount);
+	TotalActiveCount++;
+	TotalHighWaterMark = FMath::Max(TotalHighWaterMark, TotalActiveCount);
+
+	// Where it would be had it been fired on time
+	FTransform Transform = SpawnTransform;
+	if (FlightTime > 0.0f)
+	{
+		Transform.AddToTranslation(SpawnTransform.GetRotation().GetRightVector() * Dart->DartSpeed * FlightTime);
+	}
+
+	Dart->ActivateFromPool(Transform);
+	Dart->ActiveTime = FMath::Max(FlightTime, 0.0f);
+	return Dart;
+}
+
+void UDartPoolSubsystem::ReleaseDart(ADart* Dart)
+{
+	if (!Dart || !Dart->IsPooled() || Dart->bIsInPool)
+	{
+		return;
+	}
+
+	FDartPoolBucket* Bucket = Buckets.Find(Dart->GetClass());
+	if (!Bucket)
+	{
+		return;
+	}
+
+	Dart->DeactivateToPool();
+	Bucket->FreeDarts.Add(Dart);
+	Bucket->Stats.ActiveCount--;
+	TotalActiveCount--;
+}
+
+void UDartPoolSubsystem::ReleaseAllDarts()
+{
+	for (TPair<UClass*, FDartPoolBucket>& Pair : Buckets)
+	{
+		for (ADart* Dart : Pair.Value.AllDarts)
+		{
+			if (IsValid(Dart))
+			{
+				ReleaseDart(Dart);
+			}
+		}
+	}
+}
+
+FDartPoolStats UDartPoolSubsystem::GetPoolStats(TSubclassOf<ADart> DartClass) const
+{
+	const FDartPoolBucket* Bucket = Buckets.Find(DartClass);
+	return Bucket ? Bucket->Stats : FDartPoolStats();
+}
+
+FDartPoolStats UDartPoolSubsystem::GetTotalStats() const
+{
+	FDartPoolStats Total;
+	for (const TPair<UClass*, FDartPoolBucket>& Pair : Buckets)
+	{
+		Total.PooledCount += Pair.Value.Stats.PooledCount;
+		Total.ActiveCount += Pair.Value.Stats.ActiveCount;
+		Total.Misses += Pair.Value.Stats.Misses;
+	}
+	Total.HighWaterMark = TotalHighWaterMark;
+	return Total;
+}
+
+ADart* UDartPoolSubsystem::SpawnPooledDart(UClass* DartClass, FDartPoolBucket& Bucket)
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	// Deferred so the dart knows it is pooled before BeginPlay runs
+	ADart* Dart = World->SpawnActorDeferred<ADart>(DartClass, FTransform::Identity, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (!Dart)
+	{
+		return nullptr;
+	}
+
+	Dart->bIsPooled = true;
+	Dart->FinishSpawning(FTransform::Identity);
+
+	Bucket.AllDarts.Add(Dart);
+	Bucket.Stats.PooledCount = Bucket.AllDarts.Num();
+	return Dart;
+}
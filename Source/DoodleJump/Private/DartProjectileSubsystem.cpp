@@ -0,0 +1,336 @@
+#include "DartProjectileSubsystem.h"
+#include "Dart.h"
+#include "DoodleCharacter.h"
+#include "DoodleMovementComponent.h"
+#include "DoodleJump.h"
+#include "DoodleSignificanceSubsystem.h"
+#include "DoodleTrace.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+
+namespace DoodleDartProjectiles
+{
+	// Squared distance from segment [A0, A1] to the parallelogram swept by segment [B0, B1] moving by Sweep
+	static double SegmentToSweptSegmentDistSquared(const FVector& A0, const FVector& A1, const FVector& B0, const FVector& B1, const FVector& Sweep)
+	{
+		const FVector BAxis = B1 - B0;
+		const FVector Normal = FVector::CrossProduct(BAxis, Sweep);
+		const FVector ADirection = A1 - A0;
+		const double Denominator = FVector::DotProduct(Normal, ADirection);
+		if (FMath::Abs(Denominator) > UE_KINDA_SMALL_NUMBER)
+		{
+			// A passes through the plane of the parallelogram - a hit if it does so inside it
+			const double S = FVector::DotProduct(Normal, B0 - A0) / Denominator;
+			if (S >= 0.0 && S <= 1.0)
+			{
+				const FVector P = A0 + ADirection * S - B0;
+				const double AA = BAxis.SizeSquared();
+				const double AB = FVector::DotProduct(BAxis, Sweep);
+				const double BB = Sweep.SizeSquared();
+				const double PA = FVector::DotProduct(P, BAxis);
+				const double PB = FVector::DotProduct(P, Sweep);
+				const double Det = AA * BB - AB * AB;
+				const double U = (PA * BB - PB * AB) / Det;
+				const double V = (PB * AA - PA * AB) / Det;
+				if (U >= 0.0 && U <= 1.0 && V >= 0.0 && V <= 1.0)
+				{
+					return 0.0;
+				}
+			}
+		}
+
+		// Otherwise the closest point lies on one of the four edges
+		double DistSquared = UE_BIG_NUMBER;
+		auto TestEdge = [&](const FVector& E0, const FVector& E1)
+		{
+			FVector OnA, OnEdge;
+			FMath::SegmentDistToSegmentSafe(A0, A1, E0, E1, OnA, OnEdge);
+			DistSquared = FMath::Min(DistSquared, FVector::DistSquared(OnA, OnEdge));
+		};
+		TestEdge(B0, B1);
+		TestEdge(B0 + Sweep, B1 + Sweep);
+		TestEdge(B0, B0 + Sweep);
+		TestEdge(B1, B1 + Sweep);
+		return DistSquared;
+	}
+}
+
+UDartProjectileSubsystem::UDartProjectileSubsystem()
+{
+	RenderActor = nullptr;
+	LastPlayerLocation = FVector::ZeroVector;
+	bHasLastPlayerLocation = false;
+}
+
+bool UDartProjectileSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDartProjectileSubsystem::Deinitialize()
+{
+	Batches.Empty();
+	RenderActor = nullptr;
+
+	Super::Deinitialize();
+}
+
+TStatId UDartProjectileSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDartProjectileSubsystem, STATGROUP_Tickables);
+}
+
+FDartProjectileBatch* UDartProjectileSubsystem::FindOrAddBatch(UClass* DartClass)
+{
+	if (FDartProjectileBatch* Batch = Batches.Find(DartClass))
+	{
+		return Batch;
+	}
+
+	const ADart* Defaults = DartClass->GetDefaultObject<ADart>();
+	UWorld* World = GetWorld();
+	if (!Defaults || !World)
+	{
+		return nullptr;
+	}
+
+	if (!RenderActor)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		RenderActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+
+		USceneComponent* Root = NewObject<USceneComponent>(RenderActor, TEXT("RootComponent"));
+		RenderActor->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	FDartProjectileBatch& Batch = Batches.Add(DartClass);
+	Batch.Speed = Defaults->DartSpeed;
+	Batch.KnockbackForce = Defaults->KnockbackForce;
+	Batch.DotProductThreshold = Defaults->DotProductThreshold;
+	Batch.Lifetime = Defaults->Lifetime;
+	if (const UCapsuleComponent* Capsule = Defaults->CollisionCapsule)
+	{
+		Batch.Radius = Capsule->GetScaledCapsuleRadius();
+		Batch.AxisHalfLength = Capsule->GetScaledCapsuleHalfHeight() - Batch.Radius;
+		Batch.CapsuleCenter = Capsule->GetRelativeLocation();
+		Batch.CapsuleAxis = Capsule->GetRelativeRotation().Quaternion().GetUpVector();
+	}
+	else
+	{
+		Batch.Radius = 10.0f;
+	}
+	Batch.MeshRelativeTransform = Defaults->DartMesh ? Defaults->DartMesh->GetRelativeTransform() : FTransform::Identity;
+
+	// Render only - hits are resolved analytically, so the instances carry no collision
+	Batch.Instances = NewObject<UInstancedStaticMeshComponent>(RenderActor);
+	Batch.Instances->SetMobility(EComponentMobility::Movable);
+	Batch.Instances->SetupAttachment(RenderActor->GetRootComponent());
+	Batch.Instances->SetStaticMesh(Defaults->DartMesh ? Defaults->DartMesh->GetStaticMesh() : nullptr);
+	Batch.Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Batch.Instances->SetCanEverAffectNavigation(false);
+	Batch.Instances->RegisterComponent();
+
+	return &Batch;
+}
+
+void UDartProjectileSubsystem::FireDart(TSubclassOf<ADart> DartClass, const FTransform& SpawnTransform, float FlightTime)
+{
+	if (!DartClass)
+	{
+		return;
+	}
+
+	FDartProjectileBatch* Batch = FindOrAddBatch(DartClass);
+	if (!Batch || (FlightTime > 0.0f && FlightTime >= Batch->Lifetime))
+	{
+		return;
+	}
+
+	const FQuat Rotation = SpawnTransform.GetRotation();
+	Batch->Origins.Add(SpawnTransform.GetLocation());
+	Batch->Directions.Add(Rotation.GetRightVector());
+	Batch->Rotations.Add(Rotation);
+	Batch->Speeds.Add(Batch->Speed);
+	Batch->SpawnTimes.Add(GetWorld()->GetTimeSeconds() - FMath::Max(FlightTime, 0.0f));
+}
+
+int32 UDartProjectileSubsystem::GetNumDarts() const
+{
+	int32 NumDarts = 0;
+	for (const TPair<UClass*, FDartProjectileBatch>& Pair : Batches)
+	{
+		NumDarts += Pair.Value.Num();
+	}
+	return NumDarts;
+}
+
+void UDartProjectileSubsystem::RemoveDart(FDartProjectileBatch& Batch, int32 Index)
+{
+	Batch.Origins.RemoveAtSwap(Index, EAllowShrinking::No);
+	Batch.Directions.RemoveAtSwap(Index, EAllowShrinking::No);
+	Batch.Rotations.RemoveAtSwap(Index, EAllowShrinking::No);
+	Batch.Speeds.RemoveAtSwap(Index, EAllowShrinking::No);
+	Batch.SpawnTimes.RemoveAtSwap(Index, EAllowShrinking::No);
+}
+
+void UDartProjectileSubsystem::ClearDarts()
+{
+	const double Time = GetWorld()->GetTimeSeconds();
+	for (TPair<UClass*, FDartProjectileBatch>& Pair : Batches)
+	{
+		FDartProjectileBatch& Batch = Pair.Value;
+		Batch.Origins.Reset();
+		Batch.Directions.Reset();
+		Batch.Rotations.Reset();
+		Batch.Speeds.Reset();
+		Batch.SpawnTimes.Reset();
+		UpdateInstances(Batch, Time);
+	}
+
+	// The player is about to be moved back - do not sweep the darts over the jump
+	bHasLastPlayerLocation = false;
+}
+
+void UDartProjectileSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_DoodleDartProjectiles);
+	CSV_SCOPED_TIMING_STAT(DoodleJump, DartProjectiles);
+
+	Super::Tick(DeltaTime);
+
+	const double Time = GetWorld()->GetTimeSeconds();
+	ADoodleCharacter* Player = Cast<ADoodleCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+
+	// Darts that sank under the cull floor (the rising lava) expire with the ones past their lifetime
+	const UDoodleSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UDoodleSignificanceSubsystem>();
+	const double CullFloor = Significance ? Significance->GetCullFloor() : -UE_BIG_NUMBER;
+
+	int32 NumDarts = 0;
+	for (TPair<UClass*, FDartProjectileBatch>& Pair : Batches)
+	{
+		FDartProjectileBatch& Batch = Pair.Value;
+
+		for (int32 Index = Batch.Num() - 1; Index >= 0; --Index)
+		{
+			const double Age = Time - Batch.SpawnTimes[Index];
+			if (Age >= Batch.Lifetime || Batch.Origins[Index].Z + Batch.Directions[Index].Z * Batch.Speeds[Index] * Age < CullFloor)
+			{
+				RemoveDart(Batch, Index);
+			}
+		}
+
+		if (Player)
+		{
+			ResolvePlayerHits(Batch, Player, Time, DeltaTime);
+		}
+
+		UpdateInstances(Batch, Time);
+		NumDarts += Batch.Num();
+	}
+
+	bHasLastPlayerLocation = Player != nullptr;
+	if (Player)
+	{
+		LastPlayerLocation = Player->GetActorLocation();
+	}
+
+	INC_DWORD_STAT_BY(STAT_DoodleActiveDarts, NumDarts);
+	CSV_CUSTOM_STAT(DoodleJump, ActiveDarts, NumDarts, ECsvCustomStatOp::Accumulate);
+}
+
+void UDartProjectileSubsystem::ResolvePlayerHits(FDartProjectileBatch& Batch, ADoodleCharacter* Player, double Time, float DeltaTime)
+{
+	const UCapsuleComponent* Capsule = Player->GetCapsuleComponent();
+	const float PlayerRadius = Capsule->GetScaledCapsuleRadius();
+	const float AxisHalfLength = Capsule->GetScaledCapsuleHalfHeight() - PlayerRadius;
+	const FVector AxisBottom(0.0f, 0.0f, -AxisHalfLength);
+	const FVector AxisTop(0.0f, 0.0f, AxisHalfLength);
+
+	const FVector PlayerLocation = Player->GetActorLocation();
+	const FVector PreviousPlayerLocation = bHasLastPlayerLocation ? LastPlayerLocation : PlayerLocation;
+
+	const float HitDistance = PlayerRadius + Batch.Radius;
+
+	for (int32 Index = Batch.Num() - 1; Index >= 0; --Index)
+	{
+		const double Age = Time - Batch.SpawnTimes[Index];
+		const FVector Velocity = Batch.Directions[Index] * Batch.Speeds[Index];
+		const FVector Position = Batch.Origins[Index] + Velocity * Age;
+		const FVector PreviousPosition = Batch.Origins[Index] + Velocity * FMath::Max(Age - DeltaTime, 0.0);
+
+		// Dart capsule motion in the player's frame, so one capsule-vs-capsule sweep covers both movements this frame
+		const FQuat& Rotation = Batch.Rotations[Index];
+		const FVector CenterOffset = Rotation.RotateVector(Batch.CapsuleCenter);
+		const FVector DartAxis = Rotation.RotateVector(Batch.CapsuleAxis) * Batch.AxisHalfLength;
+		const FVector RelativeStart = PreviousPosition + CenterOffset - PreviousPlayerLocation;
+		const FVector RelativeEnd = Position + CenterOffset - PlayerLocation;
+		const double VerticalReach = AxisHalfLength + HitDistance + FMath::Abs(DartAxis.Z);
+		if (FMath::Min(RelativeStart.Z, RelativeEnd.Z) > VerticalReach || FMath::Max(RelativeStart.Z, RelativeEnd.Z) < -VerticalReach)
+		{
+			continue;
+		}
+
+		const double DistSquared = DoodleDartProjectiles::SegmentToSweptSegmentDistSquared(AxisBottom, AxisTop, RelativeStart - DartAxis, RelativeStart + DartAxis, RelativeEnd - RelativeStart);
+		if (DistSquared > FMath::Square(HitDistance))
+		{
+			continue;
+		}
+
+		INC_DWORD_STAT(STAT_DoodleHitEvents);
+
+		// Same rule as ADart::HandleContact: flying into the player knocks back, anything else is a platform
+		const FVector ToPlayer = (PlayerLocation - Position).GetSafeNormal();
+		const float DotProduct = FVector::DotProduct(Batch.Directions[Index], ToPlayer);
+		DOODLE_TRACE(DartHit, Batch.Instances, Player, DotProduct, Batch.DotProductThreshold, DotProduct > Batch.DotProductThreshold ? 1.0f : 0.0f, static_cast<float>(Index));
+
+		if (DotProduct > Batch.DotProductThreshold)
+		{
+			Player->ApplyKnockback(Batch.Directions[Index], Batch.KnockbackForce);
+			RemoveDart(Batch, Index);
+		}
+		else if (UDoodleMovementComponent* Movement = Player->GetDoodleMovement())
+		{
+			if (!Movement->IsFrozen() && Movement->Velocity.Z <= 0.0f && PlayerLocation.Z > Position.Z)
+			{
+				Movement->Bounce();
+			}
+		}
+	}
+}
+
+void UDartProjectileSubsystem::UpdateInstances(FDartProjectileBatch& Batch, double Time)
+{
+	if (!Batch.Instances)
+	{
+		return;
+	}
+
+	const int32 NumDarts = Batch.Num();
+	Batch.InstanceTransforms.SetNumUninitialized(NumDarts, EAllowShrinking::No);
+	for (int32 Index = 0; Index < NumDarts; ++Index)
+	{
+		const FVector Position = Batch.Origins[Index] + Batch.Directions[Index] * (Batch.Speeds[Index] * (Time - Batch.SpawnTimes[Index]));
+		Batch.InstanceTransforms[Index] = Batch.MeshRelativeTransform * FTransform(Batch.Rotations[Index], Position);
+	}
+
+	// Keep one instance per dart: grow or trim at the tail, then rewrite every transform in one batch
+	const int32 NumInstances = Batch.Instances->GetInstanceCount();
+	for (int32 Index = NumInstances - 1; Index >= NumDarts; --Index)
+	{
+		Batch.Instances->RemoveInstance(Index);
+	}
+	for (int32 Index = NumInstances; Index < NumDarts; ++Index)
+	{
+		Batch.Instances->AddInstance(Batch.InstanceTransforms[Index], true);
+	}
+
+	if (NumDarts > 0)
+	{
+		Batch.Instances->BatchUpdateInstancesTransforms(0, Batch.InstanceTransforms, true, true, true);
+	}
+}
@@ -0,0 +1,89 @@
+#include "DartTrap.h"
+#include "Dart.h"
+#include "DartPoolSubsystem.h"
+#include "DartProjectileSubsystem.h"
+#include "DartTrapSchedulerSubsystem.h"
+#include "DoodleHeightIndexSubsystem.h"
+#include "Components/StaticMeshComponent.h"
+
+ADartTrap::ADartTrap()
+{
+	// Fired by UDartTrapSchedulerSubsystem
+	PrimaryActorTick.bCanEverTick = false;
+
+	TrapMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("TrapMesh"));
+	RootComponent = TrapMesh;
+	TrapMesh->SetCollisionProfileName(TEXT("BlockAll"));
+
+	Muzzle = CreateDefaultSubobject<USceneComponent>(TEXT("Muzzle"));
+	Muzzle->SetupAttachment(TrapMesh);
+
+	DartClass = nullptr;
+	FireInterval = 2.0f;
+	BurstCount = 1;
+	BurstSpacing = 0.2f;
+	PhaseOffset = 0.0f;
+	// Darts fly along their right vector, so this keeps a dart's rotation equal to the trap's
+	FireDirection = FVector(0.0f, 1.0f, 0.0f);
+	bUseDartRecords = false;
+
+	SchedulerSlot = INDEX_NONE;
+	HeightIndexHandle = INDEX_NONE;
+}
+
+void ADartTrap::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UDartTrapSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UDartTrapSchedulerSubsystem>())
+	{
+		Scheduler->RegisterTrap(this);
+	}
+
+	// Traps spawned by another actor (the tower generator) are indexed by their owner
+	if (!GetOwner())
+	{
+		if (UDoodleHeightIndexSubsystem* HeightIndex = GetWorld()->GetSubsystem<UDoodleHeightIndexSubsystem>())
+		{
+			HeightIndexHandle = HeightIndex->AddActor(this, DHC_Trap, false);
+		}
+	}
+}
+
+void ADartTrap::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UDartTrapSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UDartTrapSchedulerSubsystem>())
+	{
+		Scheduler->UnregisterTrap(this);
+	}
+
+	if (UDoodleHeightIndexSubsystem* HeightIndex = GetWorld()->GetSubsystem<UDoodleHeightIndexSubsystem>())
+	{
+		HeightIndex->Remove(HeightIndexHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ADartTrap::Fire(float Lateness)
+{
+	if (!DartClass)
+	{
+		return;
+	}
+
+	const FVector Direction = GetActorTransform().TransformVectorNoScale(FireDirection.GetSafeNormal());
+	const FTransform SpawnTransform(FRotationMatrix::MakeFromY(Direction).Rotator(), Muzzle->GetComponentLocation());
+
+	if (bUseDartRecords)
+	{
+		if (UDartProjectileSubsystem* DartProjectiles = GetWorld()->GetSubsystem<UDartProjectileSubsystem>())
+		{
+			DartProjectiles->FireDart(DartClass, SpawnTransform, Lateness);
+		}
+	}
+	else if (UDartPoolSubsystem* DartPool = GetWorld()->GetSubsystem<UDartPoolSubsystem>())
+	{
+		DartPool->AcquireDart(DartClass, SpawnTransform, Lateness);
+	}
+}
@@ -0,0 +1,175 @@
+#include "DartTrapSchedulerSubsystem.h"
+#include "DartTrap.h"
+#include "DoodleBenchmark.h"
+#include "DoodleJump.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+
+namespace DoodleDartTrapScheduler
+{
+	struct FShotOrder
+	{
+		template<typename ShotType>
+		bool operator()(const ShotType& A, const ShotType& B) const
+		{
+			return A.Time < B.Time || (A.Time == B.Time && A.Slot < B.Slot);
+		}
+	};
+}
+
+UDartTrapSchedulerSubsystem::UDartTrapSchedulerSubsystem()
+{
+	FireDistance = 3000.0f;
+	MinFireInterval = 0.05f;
+
+	NextSerial = 0;
+}
+
+bool UDartTrapSchedulerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDartTrapSchedulerSubsystem::Deinitialize()
+{
+	for (const FSlot& Slot : Slots)
+	{
+		if (Slot.Trap)
+		{
+			Slot.Trap->SchedulerSlot = INDEX_NONE;
+		}
+	}
+
+	Slots.Empty();
+	FreeSlots.Empty();
+	Queue.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UDartTrapSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDartTrapSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+void UDartTrapSchedulerSubsystem::RegisterTrap(ADartTrap* Trap)
+{
+	if (!Trap || Trap->SchedulerSlot != INDEX_NONE)
+	{
+		return;
+	}
+
+	const int32 SlotIndex = FreeSlots.Num() > 0 ? FreeSlots.Pop(EAllowShrinking::No) : Slots.AddDefaulted();
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.Trap = Trap;
+	Slot.Serial = ++NextSerial;
+	Trap->SchedulerSlot = SlotIndex;
+
+	// Join the pattern where the world clock is - the first shot is the first one still ahead
+	const double Time = GetWorld()->GetTimeSeconds();
+	const double Interval = FMath::Max(Trap->FireInterval, MinFireInterval);
+	Slot.Cycle = FMath::Max<int64>(FMath::FloorToInt64((Time - Trap->PhaseOffset) / Interval), 0);
+	Slot.Shot = 0;
+	while (GetShotTime(Slot) < Time)
+	{
+		if (++Slot.Shot >= FMath::Max(Trap->BurstCount, 1))
+		{
+			Slot.Shot = 0;
+			Slot.Cycle++;
+		}
+	}
+
+	QueueShot(SlotIndex);
+}
+
+void UDartTrapSchedulerSubsystem::UnregisterTrap(ADartTrap* Trap)
+{
+	if (!Trap || !Slots.IsValidIndex(Trap->SchedulerSlot) || Slots[Trap->SchedulerSlot].Trap != Trap)
+	{
+		return;
+	}
+
+	// Its queued shot stays behind and is dropped when it comes up, since the serial no longer matches
+	FSlot& Slot = Slots[Trap->SchedulerSlot];
+	Slot.Trap = nullptr;
+	Slot.Serial = 0;
+	FreeSlots.Add(Trap->SchedulerSlot);
+	Trap->SchedulerSlot = INDEX_NONE;
+}
+
+double UDartTrapSchedulerSubsystem::GetShotTime(const FSlot& Slot) const
+{
+	// Absolute, not accumulated - no drift however many shots were skipped
+	const ADartTrap* Trap = Slot.Trap;
+	const double Interval = FMath::Max(Trap->FireInterval, MinFireInterval);
+	const int32 BurstCount = FMath::Max(Trap->BurstCount, 1);
+	const double Spacing = FMath::Clamp(double(Trap->BurstSpacing), 0.0, Interval / BurstCount);
+	return Trap->PhaseOffset + Slot.Cycle * Interval + Slot.Shot * Spacing;
+}
+
+void UDartTrapSchedulerSubsystem::QueueShot(int32 SlotIndex)
+{
+	const FSlot& Slot = Slots[SlotIndex];
+	Queue.HeapPush({ GetShotTime(Slot), SlotIndex, Slot.Serial }, DoodleDartTrapScheduler::FShotOrder());
+}
+
+void UDartTrapSchedulerSubsystem::Tick(float DeltaTime)
+{
+	DOODLE_BENCHMARK_TICK_SCOPE("UDartTrapSchedulerSubsystem");
+	SCOPE_CYCLE_COUNTER(STAT_DoodleDartTraps);
+	CSV_SCOPED_TIMING_STAT(DoodleJump, DartTraps);
+
+	Super::Tick(DeltaTime);
+
+	const double Time = GetWorld()->GetTimeSeconds();
+	const APawn* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	const double PlayerZ = Player ? Player->GetActorLocation().Z : 0.0;
+
+	int32 NumFired = 0;
+	int32 NumSkipped = 0;
+
+	// One pass in time order. A trap whose next shot is also due (a long frame) comes up again within the pass.
+	while (Queue.Num() > 0 && Queue.HeapTop().Time <= Time)
+	{
+		FQueuedShot Due;
+		Queue.HeapPop(Due, DoodleDartTrapScheduler::FShotOrder(), EAllowShrinking::No);
+
+		ADartTrap* Trap = Slots[Due.Slot].Trap;
+		if (Slots[Due.Slot].Serial != Due.Serial || !IsValid(Trap))
+		{
+			continue;
+		}
+
+		// Pooled traps (hidden by the tower generator) and traps out of range keep their phase but fire nothing
+		if (!Trap->IsHidden() && (!Player || FMath::Abs(Trap->GetActorLocation().Z - PlayerZ) <= FireDistance))
+		{
+			// Late shots start where they would be, not on top of each other
+			Trap->Fire(static_cast<float>(Time - Due.Time));
+			NumFired++;
+		}
+		else
+		{
+			NumSkipped++;
+		}
+
+		// Firing can spawn actors, and with them register or unregister traps - look the slot up again
+		FSlot& Slot = Slots[Due.Slot];
+		if (Slot.Serial != Due.Serial)
+		{
+			continue;
+		}
+
+		if (++Slot.Shot >= FMath::Max(Trap->BurstCount, 1))
+		{
+			Slot.Shot = 0;
+			Slot.Cycle++;
+		}
+		QueueShot(Due.Slot);
+	}
+
+	SET_DWORD_STAT(STAT_DoodleDartTrapCount, GetNumTraps());
+	INC_DWORD_STAT_BY(STAT_DoodleDartTrapShots, NumFired);
+	INC_DWORD_STAT_BY(STAT_DoodleDartTrapSkipped, NumSkipped);
+	CSV_CUSTOM_STAT(DoodleJump, DartTrapShots, NumFired, ECsvCustomStatOp::Set);
+}
@@ -0,0 +1,694 @@
+#include "DoodleBenchmarkSubsystem.h"
+#include "DoodleBenchmark.h"
+#include "DoodleJump.h"
+#include "DoodleCharacter.h"
+#include "DoodleSimulationSubsystem.h"
+#include "DoodleWorldResetSubsystem.h"
+#include "MovingPlatform.h"
+#include "BreakablePlatform.h"
+#include "Dart.h"
+#include "DartPoolSubsystem.h"
+#include "DartProjectileSubsystem.h"
+#include "MovingPlatformSubsystem.h"
+#include "EnhancedInputSubsystems.h"
+#include "InputActionValue.h"
+#include "Kismet/GameplayStatics.h"
+#include "EngineUtils.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/App.h"
+#include "HAL/FileManager.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "UObject/UObjectIterator.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+bool FDoodleBenchmarkTickTimings::bIsRecording = false;
+TMap<FName, FDoodleBenchmarkTickTimings::FEntry> FDoodleBenchmarkTickTimings::Entries;
+
+uint64 FDoodleInputLatencyProbe::FrameStartCycles = 0;
+TArray<float> FDoodleInputLatencyProbe::EventToMotionMs;
+TArray<float> FDoodleInputLatencyProbe::FrameToMotionMs;
+int32 FDoodleInputLatencyProbe::LateEvents = 0;
+uint64 FDoodleInputLatencyProbe::EventCycles = 0;
+uint64 FDoodleInputLatencyProbe::EventFrameStartCycles = 0;
+uint64 FDoodleInputLatencyProbe::EventFrame = 0;
+
+void FDoodleInputLatencyProbe::MarkFrameStart()
+{
+	FrameStartCycles = FPlatformTime::Cycles64();
+}
+
+void FDoodleInputLatencyProbe::MarkInputEvent()
+{
+	// The oldest event not yet applied is the one whose latency counts
+	if (FDoodleBenchmarkTickTimings::bIsRecording && EventCycles == 0)
+	{
+		EventCycles = FPlatformTime::Cycles64();
+		EventFrameStartCycles = FrameStartCycles;
+		EventFrame = GFrameCounter;
+	}
+}
+
+void FDoodleInputLatencyProbe::MarkMotion()
+{
+	if (EventCycles == 0)
+	{
+		return;
+	}
+
+	if (FDoodleBenchmarkTickTimings::bIsRecording)
+	{
+		const uint64 NowCycles = FPlatformTime::Cycles64();
+		EventToMotionMs.Add(static_cast<float>(FPlatformTime::ToMilliseconds64(NowCycles - EventCycles)));
+		if (EventFrameStartCycles != 0)
+		{
+			FrameToMotionMs.Add(static_cast<float>(FPlatformTime::ToMilliseconds64(NowCycles - EventFrameStartCycles)));
+		}
+		if (GFrameCounter != EventFrame)
+		{
+			LateEvents++;
+		}
+	}
+	EventCycles = 0;
+}
+
+void FDoodleInputLatencyProbe::Reset()
+{
+	EventToMotionMs.Reset();
+	FrameToMotionMs.Reset();
+	LateEvents = 0;
+	EventCycles = 0;
+}
+
+namespace DoodleBenchmark
+{
+	// Nearest-rank percentile of an already sorted array
+	static float Percentile(const TArray<float>& Sorted, float Percent)
+	{
+		if (Sorted.Num() == 0)
+		{
+			return 0.0f;
+		}
+
+		const int32 Rank = FMath::Clamp(FMath::CeilToInt(Percent / 100.0f * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Rank];
+	}
+
+	struct FSummary
+	{
+		float P50 = 0.0f;
+		float P95 = 0.0f;
+		float P99 = 0.0f;
+		float Max = 0.0f;
+		float Mean = 0.0f;
+	};
+
+	static FSummary Summarize(TArray<float> Samples)
+	{
+		FSummary Summary;
+		if (Samples.Num() == 0)
+		{
+			return Summary;
+		}
+
+		Samples.Sort();
+		Summary.P50 = Percentile(Samples, 50.0f);
+		Summary.P95 = Percentile(Samples, 95.0f);
+		Summary.P99 = Percentile(Samples, 99.0f);
+		Summary.Max = Samples.Last();
+
+		double Total = 0.0;
+		for (float Sample : Samples)
+		{
+			Total += Sample;
+		}
+		Summary.Mean = static_cast<float>(Total / Samples.Num());
+		return Summary;
+	}
+
+	struct FSkeletalMeshFootprint
+	{
+		int32 Total = 0;
+		int32 Visible = 0;
+		int32 Ticking = 0;
+		SIZE_T ComponentBytes = 0;
+	};
+
+	// What skeletal mesh components cost in the world - compare runs with doodle.LazyPlatformMeshes 0 and 1
+	static FSkeletalMeshFootprint MeasureSkeletalMeshes(const UWorld* World)
+	{
+		FSkeletalMeshFootprint Footprint;
+		for (TObjectIterator<USkeletalMeshComponent> It; It; ++It)
+		{
+			USkeletalMeshComponent* Component = *It;
+			if (Component->GetWorld() != World || !Component->IsRegistered())
+			{
+				continue;
+			}
+
+			Footprint.Total++;
+			Footprint.Visible += Component->IsVisible() ? 1 : 0;
+			Footprint.Ticking += Component->IsComponentTickEnabled() ? 1 : 0;
+			Footprint.ComponentBytes += Component->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		}
+		return Footprint;
+	}
+
+	static FString SummaryToJson(const FSummary& Summary)
+	{
+		return FString::Printf(TEXT("{ \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f, \"mean\": %.4f }"),
+			Summary.P50, Summary.P95, Summary.P99, Summary.Max, Summary.Mean);
+	}
+}
+
+UDoodleBenchmarkSubsystem::UDoodleBenchmarkSubsystem()
+{
+	Duration = 60.0f;
+	WarmupDuration = 3.0f;
+	StressMultiplier = 1;
+	StressSpacing = 400.0f;
+	DartsPerSecond = 2.0f;
+	RestartInterval = 0.0f;
+	bExitWhenDone = true;
+
+	bCaptureCsv = false;
+	bUseDartRecords = false;
+	RunTime = 0.0;
+	bFinished = false;
+	InputStepIndex = 0;
+	InputStepTime = 0.0f;
+	DartSpawnAccumulator = 0.0f;
+	WorldTickStartCycles = 0;
+	LastTickEndCycles = 0;
+	RestartAccumulator = 0.0f;
+	RestartFrame = 0;
+	LoadedDartClass = nullptr;
+}
+
+bool UDoodleBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && FParse::Param(FCommandLine::Get(), TEXT("DoodleBench"));
+}
+
+bool UDoodleBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDoodleBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	OutputDirectory = FPaths::ProjectSavedDir() / TEXT("Benchmarks");
+	ParseCommandLine();
+
+	TickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UDoodleBenchmarkSubsystem::HandleWorldTickStart);
+	TickEndHandle = FWorldDelegates::OnWorldTickEnd.AddUObject(this, &UDoodleBenchmarkSubsystem::HandleWorldTickEnd);
+}
+
+void UDoodleBenchmarkSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+	FWorldDelegates::OnWorldTickEnd.Remove(TickEndHandle);
+
+	FDoodleBenchmarkTickTimings::bIsRecording = false;
+
+	Super::Deinitialize();
+}
+
+TStatId UDoodleBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDoodleBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+void UDoodleBenchmarkSubsystem::ParseCommandLine()
+{
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FParse::Value(CommandLine, TEXT("BenchDuration="), Duration);
+	FParse::Value(CommandLine, TEXT("BenchWarmup="), WarmupDuration);
+	FParse::Value(CommandLine, TEXT("BenchStress="), StressMultiplier);
+	FParse::Value(CommandLine, TEXT("BenchOutput="), OutputDirectory);
+	FParse::Value(CommandLine, TEXT("BenchRestartEvery="), RestartInterval);
+
+	StressMultiplier = FMath::Max(StressMultiplier, 1);
+
+	FString InputFile;
+	if (FParse::Value(CommandLine, TEXT("BenchInput="), InputFile))
+	{
+		LoadInputTrack(InputFile);
+	}
+
+	if (FParse::Param(CommandLine, TEXT("BenchNoExit")))
+	{
+		bExitWhenDone = false;
+	}
+
+	bCaptureCsv = FParse::Param(CommandLine, TEXT("BenchCsv"));
+	bUseDartRecords = FParse::Param(CommandLine, TEXT("BenchDartRecords"));
+}
+
+void UDoodleBenchmarkSubsystem::LoadInputTrack(const FString& FilePath)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+	{
+		UE_LOG(LogDoodleJump, Error, TEXT("DoodleBench: Could not read input track '%s'"), *FilePath);
+		return;
+	}
+
+	InputTrack.Reset();
+	for (const FString& Line : Lines)
+	{
+		if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+		{
+			continue;
+		}
+
+		TArray<FString> Fields;
+		Line.ParseIntoArray(Fields, TEXT(","));
+		if (Fields.Num() < 3)
+		{
+			continue;
+		}
+
+		FDoodleBenchmarkInputStep& Step = InputTrack.AddDefaulted_GetRef();
+		Step.Duration = FCString::Atof(*Fields[0]);
+		Step.Value = FVector2D(FCString::Atof(*Fields[1]), FCString::Atof(*Fields[2]));
+	}
+
+	UE_LOG(LogDoodleJump, Log, TEXT("DoodleBench: Loaded %d input steps from '%s'"), InputTrack.Num(), *FilePath);
+}
+
+void UDoodleBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	LoadedDartClass = StressDartClass.TryLoadClass<ADart>();
+
+	// Fixed seed so every run fires the same volley pattern
+	StressRandom.Initialize(1234);
+
+	ApplyStress();
+
+	FDoodleBenchmarkTickTimings::Reset();
+	FDoodleInputLatencyProbe::Reset();
+	GameThreadFrameTimes.Reset();
+	FrameTimes.Reset();
+	ResetTimes.Reset();
+	RestartTimes.Reset();
+
+	// Room for the whole run at a high frame rate so recording does not reallocate
+	const int32 ExpectedFrames = FMath::CeilToInt(Duration * 300.0f);
+	GameThreadFrameTimes.Reserve(ExpectedFrames);
+	FrameTimes.Reserve(ExpectedFrames);
+
+	UE_LOG(LogDoodleJump, Log, TEXT("DoodleBench: Started on '%s' - Duration: %.1fs, Warmup: %.1fs, Stress: x%d"),
+		*UGameplayStatics::GetCurrentLevelName(&InWorld), Duration, WarmupDuration, StressMultiplier);
+}
+
+void UDoodleBenchmarkSubsystem::ApplyStress()
+{
+	if (StressMultiplier <= 1)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+
+	TArray<AMovingPlatform*> MovingPlatforms;
+	for (TActorIterator<AMovingPlatform> It(World); It; ++It)
+	{
+		MovingPlatforms.Add(*It);
+	}
+
+	TArray<UClass*> BreakableClasses;
+	BreakableClasses.Add(ABreakablePlatform::StaticClass());
+	for (const FSoftClassPath& ClassPath : StressBreakableClasses)
+	{
+		if (UClass* BreakableClass = ClassPath.TryLoadClass<AActor>())
+		{
+			BreakableClasses.Add(BreakableClass);
+		}
+	}
+
+	TArray<AActor*> Breakables;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		for (UClass* BreakableClass : BreakableClasses)
+		{
+			if (It->IsA(BreakableClass))
+			{
+				Breakables.Add(*It);
+				break;
+			}
+		}
+	}
+
+	TArray<FVector> PathPoints;
+	for (int32 Copy = 1; Copy < StressMultiplier; ++Copy)
+	{
+		// Alternate copies left and right of the original
+		const float Side = (Copy % 2 == 0) ? -1.0f : 1.0f;
+		const FVector Offset(StressSpacing * ((Copy + 1) / 2) * Side, 0.0f, 0.0f);
+
+		for (AMovingPlatform* Platform : MovingPlatforms)
+		{
+			Platform->GetPathPoints(PathPoints);
+			for (FVector& Point : PathPoints)
+			{
+				Point += Offset;
+			}
+
+			if (AMovingPlatform* Duplicate = World->SpawnActor<AMovingPlatform>(Platform->GetClass(), Platform->GetActorLocation() + Offset, Platform->GetActorRotation()))
+			{
+				Duplicate->SetPathPoints(PathPoints);
+			}
+		}
+
+		for (AActor* Breakable : Breakables)
+		{
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.Template = Breakable;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			World->SpawnActor<AActor>(Breakable->GetClass(), Breakable->GetActorLocation() + Offset, Breakable->GetActorRotation(), SpawnParams);
+		}
+	}
+
+	UE_LOG(LogDoodleJump, Log, TEXT("DoodleBench: Stress x%d - %d moving platforms, %d breakable platforms"),
+		StressMultiplier, MovingPlatforms.Num() * StressMultiplier, Breakables.Num() * StressMultiplier);
+}
+
+void UDoodleBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (bFinished)
+	{
+		return;
+	}
+
+	RunTime += DeltaTime;
+
+	ADoodleCharacter* Character = Cast<ADoodleCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+	if (Character)
+	{
+		SpawnStressDarts(Character, DeltaTime);
+	}
+
+	if (FDoodleBenchmarkTickTimings::bIsRecording)
+	{
+		MeasureRestarts(DeltaTime);
+	}
+
+	if (!FDoodleBenchmarkTickTimings::bIsRecording && RunTime >= WarmupDuration)
+	{
+		FDoodleBenchmarkTickTimings::Reset();
+		FDoodleInputLatencyProbe::Reset();
+		FDoodleBenchmarkTickTimings::bIsRecording = true;
+
+#if CSV_PROFILER
+		// Capture exactly the measured window; the .csv lands in Saved/Profiling/CSV
+		if (bCaptureCsv)
+		{
+			FCsvProfiler::Get()->BeginCapture();
+		}
+#endif
+	}
+
+	if (RunTime >= WarmupDuration + Duration)
+	{
+		FDoodleBenchmarkTickTimings::bIsRecording = false;
+		bFinished = true;
+
+#if CSV_PROFILER
+		if (bCaptureCsv)
+		{
+			FCsvProfiler::Get()->EndCapture();
+		}
+#endif
+
+		WriteReport();
+
+		if (bExitWhenDone)
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+	}
+}
+
+void UDoodleBenchmarkSubsystem::DriveInput(ADoodleCharacter* Character, float DeltaTime)
+{
+	if (InputTrack.Num() == 0 || !Character->GetMoveAction())
+	{
+		return;
+	}
+
+	// -DoodleReplay drives the player from the recording instead
+	const UDoodleSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UDoodleSimulationSubsystem>();
+	if (Simulation && Simulation->IsReplaying())
+	{
+		return;
+	}
+
+	// Advance along the looped track
+	InputStepTime += DeltaTime;
+	while (InputStepTime >= InputTrack[InputStepIndex].Duration && InputTrack[InputStepIndex].Duration > 0.0f)
+	{
+		InputStepTime -= InputTrack[InputStepIndex].Duration;
+		InputStepIndex = (InputStepIndex + 1) % InputTrack.Num();
+	}
+
+	const FVector2D Value = InputTrack[InputStepIndex].Value;
+	if (Value.IsNearlyZero())
+	{
+		return;
+	}
+
+	// Inject through Enhanced Input so the run exercises the real input path
+	APlayerController* PlayerController = Cast<APlayerController>(Character->GetController());
+	if (!PlayerController)
+	{
+		return;
+	}
+
+	if (UEnhancedInputLocalPlayerSubsystem* InputSubsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()))
+	{
+		InputSubsystem->InjectInputForAction(Character->GetMoveAction(), FInputActionValue(Value));
+	}
+}
+
+void UDoodleBenchmarkSubsystem::SpawnStressDarts(ADoodleCharacter* Character, float DeltaTime)
+{
+	if (StressMultiplier <= 1 || !LoadedDartClass)
+	{
+		return;
+	}
+
+	UDartPoolSubsystem* DartPool = GetWorld()->GetSubsystem<UDartPoolSubsystem>();
+	UDartProjectileSubsystem* DartProjectiles = GetWorld()->GetSubsystem<UDartProjectileSubsystem>();
+	if (!DartPool || !DartProjectiles)
+	{
+		return;
+	}
+
+	DartSpawnAccumulator += DartsPerSecond * StressMultiplier * DeltaTime;
+	while (DartSpawnAccumulator >= 1.0f)
+	{
+		DartSpawnAccumulator -= 1.0f;
+
+		const FVector PlayerLocation = Character->GetActorLocation();
+		const float Angle = StressRandom.FRandRange(0.0f, 2.0f * PI);
+		const FVector SpawnLocation = PlayerLocation + FVector(FMath::Cos(Angle) * 1000.0f, FMath::Sin(Angle) * 1000.0f, StressRandom.FRandRange(-300.0f, 300.0f));
+
+		// Darts fly along their right vector
+		const FVector FlightDirection = (PlayerLocation - SpawnLocation).GetSafeNormal2D();
+		const FRotator SpawnRotation = FRotationMatrix::MakeFromY(FlightDirection).Rotator();
+
+		if (bUseDartRecords)
+		{
+			DartProjectiles->FireDart(LoadedDartClass, FTransform(SpawnRotation, SpawnLocation));
+		}
+		else
+		{
+			DartPool->AcquireDart(LoadedDartClass, FTransform(SpawnRotation, SpawnLocation));
+		}
+	}
+}
+
+void UDoodleBenchmarkSubsystem::MeasureRestarts(float DeltaTime)
+{
+	UDoodleWorldResetSubsystem* Reset = GetWorld()->GetSubsystem<UDoodleWorldResetSubsystem>();
+	if (RestartInterval <= 0.0f || !Reset)
+	{
+		return;
+	}
+
+	// The reset subsystem times the first full frame after the reset, which has ended by the one after it
+	if (RestartFrame != 0 && GFrameCounter > RestartFrame + 1)
+	{
+		ResetTimes.Add(Reset->GetLastResetMs());
+		RestartTimes.Add(Reset->GetLastRestartMs());
+		RestartFrame = 0;
+	}
+
+	RestartAccumulator += DeltaTime;
+	if (RestartAccumulator >= RestartInterval && RestartFrame == 0)
+	{
+		RestartAccumulator = 0.0f;
+		RestartFrame = GFrameCounter;
+		Reset->ResetWorld();
+	}
+}
+
+void UDoodleBenchmarkSubsystem::HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	WorldTickStartCycles = FPlatformTime::Cycles64();
+	FDoodleInputLatencyProbe::MarkFrameStart();
+
+	// Injected here rather than in Tick, which runs after the actors: the player controller picks the
+	// input up this frame, like input pumped from a device, instead of one frame late
+	if (TickType == LEVELTICK_All && !bFinished)
+	{
+		if (ADoodleCharacter* Character = Cast<ADoodleCharacter>(UGameplayStatics::GetPlayerCharacter(World, 0)))
+		{
+			DriveInput(Character, DeltaSeconds);
+		}
+	}
+}
+
+void UDoodleBenchmarkSubsystem::HandleWorldTickEnd(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld() || !FDoodleBenchmarkTickTimings::bIsRecording || WorldTickStartCycles == 0)
+	{
+		return;
+	}
+
+	const uint64 NowCycles = FPlatformTime::Cycles64();
+	GameThreadFrameTimes.Add(static_cast<float>(FPlatformTime::ToMilliseconds64(NowCycles - WorldTickStartCycles)));
+
+	// Wall clock between frames - FApp's delta is the fixed step under -DoodleFixedStep
+	if (LastTickEndCycles != 0)
+	{
+		FrameTimes.Add(static_cast<float>(FPlatformTime::ToMilliseconds64(NowCycles - LastTickEndCycles)));
+	}
+	LastTickEndCycles = NowCycles;
+}
+
+void UDoodleBenchmarkSubsystem::WriteReport()
+{
+	UWorld* World = GetWorld();
+	const FString MapName = UGameplayStatics::GetCurrentLevelName(World);
+	const FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"));
+	const int32 NumFrames = GameThreadFrameTimes.Num();
+
+	const DoodleBenchmark::FSummary GameThread = DoodleBenchmark::Summarize(GameThreadFrameTimes);
+	const DoodleBenchmark::FSummary Frame = DoodleBenchmark::Summarize(FrameTimes);
+	const DoodleBenchmark::FSummary Reset = DoodleBenchmark::Summarize(ResetTimes);
+	const DoodleBenchmark::FSummary Restart = DoodleBenchmark::Summarize(RestartTimes);
+	const DoodleBenchmark::FSummary EventToMotion = DoodleBenchmark::Summarize(FDoodleInputLatencyProbe::EventToMotionMs);
+	const DoodleBenchmark::FSummary FrameToMotion = DoodleBenchmark::Summarize(FDoodleInputLatencyProbe::FrameToMotionMs);
+
+	int32 NumMovingPlatforms = 0;
+	if (const UMovingPlatformSubsystem* PlatformSubsystem = World->GetSubsystem<UMovingPlatformSubsystem>())
+	{
+		NumMovingPlatforms = PlatformSubsystem->GetNumPlatforms();
+	}
+
+	int32 NumDartRecords = 0;
+	if (const UDartProjectileSubsystem* DartProjectiles = World->GetSubsystem<UDartProjectileSubsystem>())
+	{
+		NumDartRecords = DartProjectiles->GetNumDarts();
+	}
+
+	FDartPoolStats DartStats;
+	if (const UDartPoolSubsystem* DartPool = World->GetSubsystem<UDartPoolSubsystem>())
+	{
+		DartStats = DartPool->GetTotalStats();
+	}
+
+	const DoodleBenchmark::FSkeletalMeshFootprint SkeletalMeshes = DoodleBenchmark::MeasureSkeletalMeshes(World);
+
+	// Fixed-step runs replaying the same recording are the comparable ones
+	int32 FixedStepHz = 0;
+	bool bInputReplay = false;
+	if (const UDoodleSimulationSubsystem* Simulation = World->GetSubsystem<UDoodleSimulationSubsystem>())
+	{
+		FixedStepHz = Simulation->IsFixedStep() ? Simulation->GetFixedStepHz() : 0;
+		bInputReplay = Simulation->IsReplaying();
+	}
+
+	// Per-class tick times, most expensive first
+	FDoodleBenchmarkTickTimings::Entries.ValueSort([](const FDoodleBenchmarkTickTimings::FEntry& A, const FDoodleBenchmarkTickTimings::FEntry& B)
+	{
+		return A.Cycles > B.Cycles;
+	});
+
+	TArray<FString> TickEntries;
+	for (const TPair<FName, FDoodleBenchmarkTickTimings::FEntry>& Pair : FDoodleBenchmarkTickTimings::Entries)
+	{
+		const double TotalMs = FPlatformTime::ToMilliseconds64(Pair.Value.Cycles);
+		TickEntries.Add(FString::Printf(TEXT("    { \"name\": \"%s\", \"calls\": %d, \"total_ms\": %.4f, \"ms_per_frame\": %.4f, \"us_per_call\": %.4f }"),
+			*Pair.Key.ToString(), Pair.Value.Calls, TotalMs,
+			NumFrames > 0 ? TotalMs / NumFrames : 0.0,
+			Pair.Value.Calls > 0 ? TotalMs * 1000.0 / Pair.Value.Calls : 0.0));
+	}
+
+	const FString Json = FString::Printf(
+		TEXT("{\n")
+		TEXT("  \"map\": \"%s\",\n")
+		TEXT("  \"timestamp\": \"%s\",\n")
+		TEXT("  \"duration_s\": %.2f,\n")
+		TEXT("  \"stress\": %d,\n")
+		TEXT("  \"fixed_step_hz\": %d,\n")
+		TEXT("  \"input_replay\": %s,\n")
+		TEXT("  \"frames\": %d,\n")
+		TEXT("  \"game_thread_ms\": %s,\n")
+		TEXT("  \"frame_ms\": %s,\n")
+		TEXT("  \"moving_platforms\": %d,\n")
+		TEXT("  \"dart_pool\": { \"pooled\": %d, \"high_water_mark\": %d, \"misses\": %d },\n")
+		TEXT("  \"dart_records\": %d,\n")
+		TEXT("  \"skeletal_meshes\": { \"total\": %d, \"visible\": %d, \"ticking\": %d, \"component_kb\": %.1f },\n")
+		TEXT("  \"restarts\": { \"count\": %d, \"reset_ms\": %s, \"next_frame_ms\": %s },\n")
+		TEXT("  \"input_latency\": { \"events\": %d, \"late_events\": %d, \"event_to_motion_ms\": %s, \"frame_start_to_motion_ms\": %s },\n")
+		TEXT("  \"ticks\": [\n%s\n  ]\n")
+		TEXT("}\n"),
+		*MapName, *Timestamp, Duration, StressMultiplier, FixedStepHz, bInputReplay ? TEXT("true") : TEXT("false"), NumFrames,
+		*DoodleBenchmark::SummaryToJson(GameThread), *DoodleBenchmark::SummaryToJson(Frame),
+		NumMovingPlatforms, DartStats.PooledCount, DartStats.HighWaterMark, DartStats.Misses, NumDartRecords,
+		SkeletalMeshes.Total, SkeletalMeshes.Visible, SkeletalMeshes.Ticking, SkeletalMeshes.ComponentBytes / 1024.0,
+		RestartTimes.Num(), *DoodleBenchmark::SummaryToJson(Reset), *DoodleBenchmark::SummaryToJson(Restart),
+		FDoodleInputLatencyProbe::EventToMotionMs.Num(), FDoodleInputLatencyProbe::LateEvents,
+		*DoodleBenchmark::SummaryToJson(EventToMotion), *DoodleBenchmark::SummaryToJson(FrameToMotion),
+		*FString::Join(TickEntries, TEXT(",\n")));
+
+	IFileManager::Get().MakeDirectory(*OutputDirectory, true);
+
+	const FString JsonPath = OutputDirectory / FString::Printf(TEXT("%s-x%d-%s.json"), *MapName, StressMultiplier, *Timestamp);
+	FFileHelper::SaveStringToFile(Json, *JsonPath);
+
+	// One row per run in a cumulative CSV so scaling curves can be plotted across stress levels
+	const FString CsvPath = OutputDirectory / TEXT("BenchmarkResults.csv");
+	FString CsvRow;
+	if (!IFileManager::Get().FileExists(*CsvPath))
+	{
+		CsvRow += TEXT("Timestamp,Map,Stress,Frames,GameThreadP50,GameThreadP95,GameThreadP99,GameThreadMax,FrameP50,FrameP95,FrameP99,FrameMax,MovingPlatforms,DartHighWaterMark,DartMisses\n");
+	}
+	CsvRow += FString::Printf(TEXT("%s,%s,%d,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%d,%d,%d\n"),
+		*Timestamp, *MapName, StressMultiplier, NumFrames,
+		GameThread.P50, GameThread.P95, GameThread.P99, GameThread.Max,
+		Frame.P50, Frame.P95, Frame.P99, Frame.Max,
+		NumMovingPlatforms, DartStats.HighWaterMark, DartStats.Misses);
+	FFileHelper::SaveStringToFile(CsvRow, *CsvPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+
+	UE_LOG(LogDoodleJump, Log, TEXT("DoodleBench: %d frames, game thread p50 %.3fms p95 %.3fms p99 %.3fms max %.3fms - report: %s"),
+		NumFrames, GameThread.P50, GameThread.P95, GameThread.P99, GameThread.Max, *JsonPath);
+	UE_LOG(LogDoodleJump, Log, TEXT("DoodleBench: input to motion p50 %.3fms p99 %.3fms from frame start, %d of %d move events applied a frame late"),
+		FrameToMotion.P50, FrameToMotion.P99, FDoodleInputLatencyProbe::LateEvents, FDoodleInputLatencyProbe::EventToMotionMs.Num());
+}
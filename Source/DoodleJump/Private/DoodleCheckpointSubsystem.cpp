@@ -0,0 +1,618 @@
+#include "DoodleCheckpointSubsystem.h"
+#include "BreakablePlatform.h"
+#include "Dart.h"
+#include "DartPoolSubsystem.h"
+#include "DartProjectileSubsystem.h"
+#include "DoodleCharacter.h"
+#include "DoodleContactSubsystem.h"
+#include "DoodleJump.h"
+#include "DoodleMovementComponent.h"
+#include "DoodleTowerGenerator.h"
+#include "MovingPlatform.h"
+#include "MovingPlatformSubsystem.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace DoodleCheckpoint
+{
+	static constexpr uint32 Magic = 0x4B434447; // "DGCK"
+	static constexpr uint16 Version = 1;
+
+	// Sections start with an element count that is only known once they are written
+	struct FCountScope
+	{
+		FArchive& Ar;
+		int64 Offset;
+		int32 Count = 0;
+
+		explicit FCountScope(FArchive& InAr)
+			: Ar(InAr)
+			, Offset(InAr.Tell())
+		{
+			Ar << Count;
+		}
+
+		~FCountScope()
+		{
+			const int64 End = Ar.Tell();
+			Ar.Seek(Offset);
+			Ar << Count;
+			Ar.Seek(End);
+		}
+	};
+
+	static FAutoConsoleCommandWithWorld SaveCommand(
+		TEXT("doodle.SaveCheckpoint"),
+		TEXT("Capture the gameplay state as the current checkpoint."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (UDoodleCheckpointSubsystem* Checkpoints = World ? World->GetSubsystem<UDoodleCheckpointSubsystem>() : nullptr)
+			{
+				Checkpoints->SaveCheckpoint();
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorld LoadCommand(
+		TEXT("doodle.LoadCheckpoint"),
+		TEXT("Restore the gameplay state from the current checkpoint."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (UDoodleCheckpointSubsystem* Checkpoints = World ? World->GetSubsystem<UDoodleCheckpointSubsystem>() : nullptr)
+			{
+				Checkpoints->RestoreCheckpoint();
+			}
+		}));
+}
+
+UDoodleCheckpointSubsystem::UDoodleCheckpointSubsystem()
+{
+	ReserveBytes = 64 * 1024;
+	ReserveReferences = 2048;
+
+	LastCaptureMs = 0.0f;
+	LastRestoreMs = 0.0f;
+}
+
+bool UDoodleCheckpointSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDoodleCheckpointSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Checkpoint.Data.Reserve(ReserveBytes);
+	Checkpoint.References.Reserve(ReserveReferences);
+}
+
+void UDoodleCheckpointSubsystem::Deinitialize()
+{
+	Checkpoint.Data.Empty();
+	Checkpoint.References.Empty();
+	Checkpointed.Empty();
+
+	Super::Deinitialize();
+}
+
+void UDoodleCheckpointSubsystem::RegisterCheckpointed(AActor* Actor, FDoodleCheckpointDelegate OnSerialize)
+{
+	if (Actor)
+	{
+		Checkpointed.Add(Actor, MoveTemp(OnSerialize));
+	}
+}
+
+void UDoodleCheckpointSubsystem::UnregisterCheckpointed(AActor* Actor)
+{
+	Checkpointed.Remove(Actor);
+}
+
+int32 UDoodleCheckpointSubsystem::AddReference(UObject* Object)
+{
+	return Object ? Checkpoint.References.Add(Object) : INDEX_NONE;
+}
+
+void UDoodleCheckpointSubsystem::SaveCheckpoint()
+{
+	SCOPE_CYCLE_COUNTER(STAT_DoodleCheckpoint);
+	CSV_SCOPED_TIMING_STAT(DoodleJump, Checkpoint);
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	// Reset keeps the reserved capacity
+	Checkpoint.Data.Reset();
+	Checkpoint.References.Reset();
+
+	FMemoryWriter Ar(Checkpoint.Data);
+	uint32 Magic = DoodleCheckpoint::Magic;
+	uint16 Version = DoodleCheckpoint::Version;
+	Ar << Magic << Version;
+
+	SaveDarts(Ar);
+	SaveTowerGenerators(Ar);
+	SaveBreakablePlatforms(Ar);
+	SaveMovingPlatforms(Ar);
+	SaveCharacters(Ar);
+	SaveCheckpointed(Ar);
+
+	LastCaptureMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	SET_DWORD_STAT(STAT_DoodleCheckpointBytes, Checkpoint.GetSizeBytes());
+
+	UE_LOG(LogDoodleJump, Log, TEXT("Checkpoint: captured %d bytes (%d data, %d references) in %.3f ms"),
+		Checkpoint.GetSizeBytes(), Checkpoint.Data.Num(), Checkpoint.References.Num(), LastCaptureMs);
+}
+
+bool UDoodleCheckpointSubsystem::RestoreCheckpoint()
+{
+	if (!Checkpoint.IsValid())
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_DoodleCheckpoint);
+	CSV_SCOPED_TIMING_STAT(DoodleJump, Checkpoint);
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	FMemoryReader Ar(Checkpoint.Data);
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	Ar << Magic << Version;
+	if (Magic != DoodleCheckpoint::Magic || Version != DoodleCheckpoint::Version)
+	{
+		UE_LOG(LogDoodleJump, Warning, TEXT("Checkpoint: unreadable snapshot"));
+		return false;
+	}
+
+	// Same order as SaveCheckpoint: darts first so nothing in flight hits the restored character
+	RestoreDarts(Ar);
+	RestoreTowerGenerators(Ar);
+	RestoreBreakablePlatforms(Ar);
+	RestoreMovingPlatforms(Ar);
+	RestoreCharacters(Ar);
+	RestoreCheckpointed(Ar);
+
+	if (UDoodleContactSubsystem* Contacts = GetWorld()->GetSubsystem<UDoodleContactSubsystem>())
+	{
+		Contacts->ClearPendingContacts();
+	}
+
+	LastRestoreMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	UE_LOG(LogDoodleJump, Log, TEXT("Checkpoint: restored %d bytes in %.3f ms%s"),
+		Checkpoint.GetSizeBytes(), LastRestoreMs, Ar.IsError() ? TEXT(" (truncated)") : TEXT(""));
+	return !Ar.IsError();
+}
+
+void UDoodleCheckpointSubsystem::SaveCharacters(FArchive& Ar)
+{
+	DoodleCheckpoint::FCountScope Section(Ar);
+
+	for (TActorIterator<ADoodleCharacter> It(GetWorld()); It; ++It)
+	{
+		ADoodleCharacter* Character = *It;
+		UDoodleMovementComponent* Movement = Character->GetDoodleMovement();
+		if (!Movement)
+		{
+			continue;
+		}
+
+		int32 CharacterRef = AddReference(Character);
+		FVector3f Location(Character->GetActorLocation());
+		FRotator3f Rotation(Character->GetActorRotation());
+		FVector3f Velocity(Movement->Velocity);
+		FRotator3f ControlRotation(Character->GetControlRotation());
+		uint8 State = static_cast<uint8>(Movement->DoodleState);
+		float StateTimeRemaining = Movement->StateTimeRemaining;
+		int32 AttachmentRef = AddReference(Movement->FreezeAttachmentActor);
+		FVector3f AttachmentOffset(Movement->FreezeRelativeOffset);
+
+		Ar << CharacterRef << Location << Rotation << Velocity << ControlRotation << State << StateTimeRemaining << AttachmentRef << AttachmentOffset;
+		Section.Count++;
+	}
+}
+
+void UDoodleCheckpointSubsystem::RestoreCharacters(FArchive& Ar)
+{
+	int32 Count = 0;
+	Ar << Count;
+
+	for (int32 Index = 0; Index < Count && !Ar.IsError(); ++Index)
+	{
+		int32 CharacterRef = INDEX_NONE;
+		FVector3f Location;
+		FRotator3f Rotation;
+		FVector3f Velocity;
+		FRotator3f ControlRotation;
+		uint8 State = 0;
+		float StateTimeRemaining = 0.0f;
+		int32 AttachmentRef = INDEX_NONE;
+		FVector3f AttachmentOffset;
+		Ar << CharacterRef << Location << Rotation << Velocity << ControlRotation << State << StateTimeRemaining << AttachmentRef << AttachmentOffset;
+
+		ADoodleCharacter* Character = ResolveReference<ADoodleCharacter>(CharacterRef);
+		UDoodleMovementComponent* Movement = Character ? Character->GetDoodleMovement() : nullptr;
+		if (!Movement)
+		{
+			continue;
+		}
+
+		Movement->ResetDoodleState();
+		Character->SetActorLocationAndRotation(FVector(Location), FRotator(Rotation), false, nullptr, ETeleportType::TeleportPhysics);
+		if (AController* Controller = Character->GetController())
+		{
+			Controller->SetControlRotation(FRotator(ControlRotation));
+		}
+		Character->ConsumeMovementInputVector();
+
+		Movement->Velocity = FVector(Velocity);
+		Movement->DoodleState = static_cast<EDoodleMovementState>(State);
+		Movement->StateTimeRemaining = StateTimeRemaining;
+		Movement->FreezeAttachmentActor = ResolveReference<AActor>(AttachmentRef);
+		Movement->FreezeRelativeOffset = FVector(AttachmentOffset);
+		if (Movement->IsFrozen())
+		{
+			Movement->StartFreezeCarry();
+		}
+	}
+}
+
+void UDoodleCheckpointSubsystem::SaveMovingPlatforms(FArchive& Ar)
+{
+	DoodleCheckpoint::FCountScope Section(Ar);
+
+	UMovingPlatformSubsystem* MovingPlatforms = GetWorld()->GetSubsystem<UMovingPlatformSubsystem>();
+	if (!MovingPlatforms)
+	{
+		return;
+	}
+
+	// The path is closed-form in time, so the time since the platform started covers segment, direction and position
+	const double Time = GetWorld()->GetTimeSeconds();
+	for (int32 Index = 0; Index < MovingPlatforms->Platforms.Num(); ++Index)
+	{
+		int32 PlatformRef = AddReference(MovingPlatforms->Platforms[Index]);
+		float PathTime = static_cast<float>(Time - MovingPlatforms->StartTimes[Index]);
+		Ar << PlatformRef << PathTime;
+		Section.Count++;
+	}
+}
+
+void UDoodleCheckpointSubsystem::RestoreMovingPlatforms(FArchive& Ar)
+{
+	int32 Count = 0;
+	Ar << Count;
+
+	UMovingPlatformSubsystem* MovingPlatforms = GetWorld()->GetSubsystem<UMovingPlatformSubsystem>();
+	const double Time = GetWorld()->GetTimeSeconds();
+
+	for (int32 Index = 0; Index < Count && !Ar.IsError(); ++Index)
+	{
+		int32 PlatformRef = INDEX_NONE;
+		float PathTime = 0.0f;
+		Ar << PlatformRef << PathTime;
+
+		const AMovingPlatform* Platform = ResolveReference<AMovingPlatform>(PlatformRef);
+		if (!MovingPlatforms || !Platform || !MovingPlatforms->Platforms.IsValidIndex(Platform->ManagerIndex))
+		{
+			continue;
+		}
+
+		const int32 PlatformIndex = Platform->ManagerIndex;
+		MovingPlatforms->StartTimes[PlatformIndex] = Time - PathTime;
+		MovingPlatforms->NextUpdateTimes[PlatformIndex] = 0.0;
+		MovingPlatforms->UpdatePlatform(PlatformIndex, Time, nullptr);
+	}
+
+	// Moved now rather than on the next Tick, so frozen characters follow the right spot
+	if (MovingPlatforms)
+	{
+		MovingPlatforms->ApplyTransforms();
+	}
+}
+
+void UDoodleCheckpointSubsystem::SaveBreakablePlatforms(FArchive& Ar)
+{
+	// Only the broken ones - everything else is intact
+	DoodleCheckpoint::FCountScope Section(Ar);
+
+	for (TActorIterator<ABreakablePlatform> It(GetWorld()); It; ++It)
+	{
+		if (It->IsBroken())
+		{
+			int32 PlatformRef = AddReference(*It);
+			Ar << PlatformRef;
+			Section.Count++;
+		}
+	}
+}
+
+void UDoodleCheckpointSubsystem::RestoreBreakablePlatforms(FArchive& Ar)
+{
+	int32 Count = 0;
+	Ar << Count;
+
+	// Everything broken goes back together first, then the platforms broken at the checkpoint break again
+	for (TActorIterator<ABreakablePlatform> It(GetWorld()); It; ++It)
+	{
+		if (It->IsBroken())
+		{
+			It->ResetPlatform();
+		}
+	}
+
+	for (int32 Index = 0; Index < Count && !Ar.IsError(); ++Index)
+	{
+		int32 PlatformRef = INDEX_NONE;
+		Ar << PlatformRef;
+
+		if (ABreakablePlatform* Platform = ResolveReference<ABreakablePlatform>(PlatformRef))
+		{
+			Platform->RestoreBroken();
+		}
+	}
+}
+
+void UDoodleCheckpointSubsystem::SaveTowerGenerators(FArchive& Ar)
+{
+	DoodleCheckpoint::FCountScope Section(Ar);
+
+	for (TActorIterator<ADoodleTowerGenerator> It(GetWorld()); It; ++It)
+	{
+		ADoodleTowerGenerator* Generator = *It;
+		int32 GeneratorRef = AddReference(Generator);
+		int32 NextChunkToPlan = Generator->NextChunkToPlan;
+		int32 NumChunks = Generator->Chunks.Num();
+		Ar << GeneratorRef << NextChunkToPlan << NumChunks;
+
+		for (const FDoodleTowerChunk& Chunk : Generator->Chunks)
+		{
+			int32 ChunkIndex = Chunk.Index;
+			int32 NumActors = Chunk.Actors.Num();
+			Ar << ChunkIndex << NumActors;
+			for (int32 ActorIndex = 0; ActorIndex < NumActors; ++ActorIndex)
+			{
+				int32 PlatformRef = AddReference(Chunk.Actors[ActorIndex]);
+				int32 TypeIndex = Chunk.TypeIndices[ActorIndex];
+				FVector3f Location(Chunk.Locations[ActorIndex]);
+				FVector3f MoveAxis(Chunk.MoveAxes[ActorIndex]);
+				Ar << PlatformRef << TypeIndex << Location << MoveAxis;
+			}
+		}
+
+		// Placements not made yet - restored as the queue the generator works through
+		int32 NumPending = Generator->PendingPlacements.Num() - Generator->PendingHead;
+		Ar << NumPending;
+		for (int32 Index = Generator->PendingHead; Index < Generator->PendingPlacements.Num(); ++Index)
+		{
+			const ADoodleTowerGenerator::FPendingPlacement& Placement = Generator->PendingPlacements[Index];
+			int32 ChunkIndex = Placement.ChunkIndex;
+			int32 TypeIndex = Placement.TypeIndex;
+			FVector3f Location(Placement.Location);
+			FVector3f MoveAxis(Placement.MoveAxis);
+			Ar << ChunkIndex << TypeIndex << Location << MoveAxis;
+		}
+
+		Section.Count++;
+	}
+}
+
+void UDoodleCheckpointSubsystem::RestoreTowerGenerators(FArchive& Ar)
+{
+	int32 Count = 0;
+	Ar << Count;
+
+	for (int32 Index = 0; Index < Count && !Ar.IsError(); ++Index)
+	{
+		int32 GeneratorRef = INDEX_NONE;
+		int32 NextChunkToPlan = 0;
+		int32 NumChunks = 0;
+		Ar << GeneratorRef << NextChunkToPlan << NumChunks;
+
+		TArray<FDoodleTowerChunk> Chunks;
+		for (int32 ChunkSlot = 0; ChunkSlot < NumChunks && !Ar.IsError(); ++ChunkSlot)
+		{
+			FDoodleTowerChunk& Chunk = Chunks.AddDefaulted_GetRef();
+			int32 NumActors = 0;
+			Ar << Chunk.Index << NumActors;
+			for (int32 ActorIndex = 0; ActorIndex < NumActors && !Ar.IsError(); ++ActorIndex)
+			{
+				int32 PlatformRef = INDEX_NONE;
+				int32 TypeIndex = 0;
+				FVector3f Location;
+				FVector3f MoveAxis;
+				Ar << PlatformRef << TypeIndex << Location << MoveAxis;
+
+				Chunk.Actors.Add(ResolveReference<AActor>(PlatformRef));
+				Chunk.TypeIndices.Add(TypeIndex);
+				Chunk.Locations.Add(FVector(Location));
+				Chunk.MoveAxes.Add(FVector(MoveAxis));
+			}
+		}
+
+		int32 NumPending = 0;
+		Ar << NumPending;
+		TArray<ADoodleTowerGenerator::FPendingPlacement> PendingPlacements;
+		for (int32 PendingIndex = 0; PendingIndex < NumPending && !Ar.IsError(); ++PendingIndex)
+		{
+			int32 ChunkIndex = 0;
+			int32 TypeIndex = 0;
+			FVector3f Location;
+			FVector3f MoveAxis;
+			Ar << ChunkIndex << TypeIndex << Location << MoveAxis;
+
+			ADoodleTowerGenerator::FPendingPlacement& Placement = PendingPlacements.AddDefaulted_GetRef();
+			Placement.ChunkIndex = ChunkIndex;
+			Placement.TypeIndex = TypeIndex;
+			Placement.Location = FVector(Location);
+			Placement.MoveAxis = FVector(MoveAxis);
+		}
+
+		ADoodleTowerGenerator* Generator = ResolveReference<ADoodleTowerGenerator>(GeneratorRef);
+		if (Generator && !Ar.IsError())
+		{
+			Generator->RestoreChunks(Chunks, PendingPlacements, NextChunkToPlan);
+		}
+	}
+}
+
+void UDoodleCheckpointSubsystem::SaveDarts(FArchive& Ar)
+{
+	UWorld* World = GetWorld();
+
+	{
+		DoodleCheckpoint::FCountScope Section(Ar);
+		for (TActorIterator<ADart> It(World); It; ++It)
+		{
+			ADart* Dart = *It;
+			if (Dart->bIsInPool)
+			{
+				continue;
+			}
+
+			int32 ClassRef = AddReference(Dart->GetClass());
+			FVector3f Location(Dart->GetActorLocation());
+			FRotator3f Rotation(Dart->GetActorRotation());
+			float ActiveTime = Dart->ActiveTime;
+			Ar << ClassRef << Location << Rotation << ActiveTime;
+			Section.Count++;
+		}
+	}
+
+	DoodleCheckpoint::FCountScope Section(Ar);
+	UDartProjectileSubsystem* Projectiles = World->GetSubsystem<UDartProjectileSubsystem>();
+	if (!Projectiles)
+	{
+		return;
+	}
+
+	const double Time = World->GetTimeSeconds();
+	for (TPair<UClass*, FDartProjectileBatch>& Pair : Projectiles->Batches)
+	{
+		const FDartProjectileBatch& Batch = Pair.Value;
+		for (int32 Index = 0; Index < Batch.Num(); ++Index)
+		{
+			int32 ClassRef = AddReference(Pair.Key);
+			FVector3f Origin(Batch.Origins[Index]);
+			FVector3f Direction(Batch.Directions[Index]);
+			FQuat4f Rotation(Batch.Rotations[Index]);
+			float Speed = Batch.Speeds[Index];
+			float Age = static_cast<float>(Time - Batch.SpawnTimes[Index]);
+			Ar << ClassRef << Origin << Direction << Rotation << Speed << Age;
+			Section.Count++;
+		}
+	}
+}
+
+void UDoodleCheckpointSubsystem::RestoreDarts(FArchive& Ar)
+{
+	UWorld* World = GetWorld();
+	UDartPoolSubsystem* DartPool = World->GetSubsystem<UDartPoolSubsystem>();
+	UDartProjectileSubsystem* Projectiles = World->GetSubsystem<UDartProjectileSubsystem>();
+
+	// Clear the sky, then bring back what was flying at the checkpoint
+	for (TActorIterator<ADart> It(World); It; ++It)
+	{
+		if (!It->bIsInPool)
+		{
+			It->Expire();
+		}
+	}
+
+	int32 Count = 0;
+	Ar << Count;
+	for (int32 Index = 0; Index < Count && !Ar.IsError(); ++Index)
+	{
+		int32 ClassRef = INDEX_NONE;
+		FVector3f Location;
+		FRotator3f Rotation;
+		float ActiveTime = 0.0f;
+		Ar << ClassRef << Location << Rotation << ActiveTime;
+
+		// Darts spawned outside the pool come back pooled
+		UClass* DartClass = ResolveReference<UClass>(ClassRef);
+		ADart* Dart = DartPool && DartClass ? DartPool->AcquireDart(DartClass, FTransform(FRotator(Rotation), FVector(Location))) : nullptr;
+		if (Dart)
+		{
+			Dart->ActiveTime = ActiveTime;
+		}
+	}
+
+	if (Projectiles)
+	{
+		Projectiles->ClearDarts();
+	}
+
+	const double Time = World->GetTimeSeconds();
+	Ar << Count;
+	for (int32 Index = 0; Index < Count && !Ar.IsError(); ++Index)
+	{
+		int32 ClassRef = INDEX_NONE;
+		FVector3f Origin;
+		FVector3f Direction;
+		FQuat4f Rotation;
+		float Speed = 0.0f;
+		float Age = 0.0f;
+		Ar << ClassRef << Origin << Direction << Rotation << Speed << Age;
+
+		UClass* DartClass = ResolveReference<UClass>(ClassRef);
+		FDartProjectileBatch* Batch = Projectiles && DartClass ? Projectiles->FindOrAddBatch(DartClass) : nullptr;
+		if (Batch)
+		{
+			Batch->Origins.Add(FVector(Origin));
+			Batch->Directions.Add(FVector(Direction));
+			Batch->Rotations.Add(FQuat(Rotation));
+			Batch->Speeds.Add(Speed);
+			Batch->SpawnTimes.Add(Time - Age);
+		}
+	}
+}
+
+void UDoodleCheckpointSubsystem::SaveCheckpointed(FArchive& Ar)
+{
+	DoodleCheckpoint::FCountScope Section(Ar);
+
+	for (const TPair<TObjectKey<AActor>, FDoodleCheckpointDelegate>& Entry : Checkpointed)
+	{
+		AActor* Actor = Entry.Key.ResolveObjectPtr();
+		if (!Actor || !Entry.Value.IsBound())
+		{
+			continue;
+		}
+
+		int32 ActorRef = AddReference(Actor);
+		Ar << ActorRef;
+
+		// The size goes in front, so a restore can step over actors that have gone
+		DoodleCheckpoint::FCountScope Size(Ar);
+		const int64 Start = Ar.Tell();
+		Entry.Value.Execute(Ar);
+		Size.Count = static_cast<int32>(Ar.Tell() - Start);
+		Section.Count++;
+	}
+}
+
+void UDoodleCheckpointSubsystem::RestoreCheckpointed(FArchive& Ar)
+{
+	int32 Count = 0;
+	Ar << Count;
+
+	for (int32 Index = 0; Index < Count && !Ar.IsError(); ++Index)
+	{
+		int32 ActorRef = INDEX_NONE;
+		int32 Size = 0;
+		Ar << ActorRef << Size;
+
+		const int64 End = Ar.Tell() + Size;
+		AActor* Actor = ResolveReference<AActor>(ActorRef);
+		if (const FDoodleCheckpointDelegate* OnSerialize = Actor ? Checkpointed.Find(Actor) : nullptr)
+		{
+			OnSerialize->ExecuteIfBound(Ar);
+		}
+
+		// Whatever the actor read, the next entry starts after this one
+		Ar.Seek(End);
+	}
+}
@@ -0,0 +1,174 @@
+#include "DoodleContactSubsystem.h"
+#include "DoodleCharacter.h"
+#include "DoodleJump.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+
+namespace DoodleContact
+{
+	// Normals steeper than this count as a top or bottom contact
+	static constexpr double TopBottomNormalZ = 0.7;
+}
+
+bool UDoodleContactSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDoodleContactSubsystem::Deinitialize()
+{
+	for (const TPair<TObjectKey<UPrimitiveComponent>, FDoodleContactDelegate>& Hazard : Hazards)
+	{
+		if (UPrimitiveComponent* Component = Hazard.Key.ResolveObjectPtr())
+		{
+			Component->OnComponentHit.RemoveDynamic(this, &UDoodleContactSubsystem::HandleComponentHit);
+		}
+	}
+
+	Hazards.Empty();
+	PendingContacts.Empty();
+	DispatchingContacts.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UDoodleContactSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDoodleContactSubsystem, STATGROUP_Tickables);
+}
+
+void UDoodleContactSubsystem::RegisterHazard(UPrimitiveComponent* Component, FDoodleContactDelegate OnContact)
+{
+	if (!Component)
+	{
+		return;
+	}
+
+	Hazards.Add(Component, MoveTemp(OnContact));
+	Component->OnComponentHit.AddUniqueDynamic(this, &UDoodleContactSubsystem::HandleComponentHit);
+}
+
+void UDoodleContactSubsystem::UnregisterHazard(UPrimitiveComponent* Component)
+{
+	if (!Component || Hazards.Remove(Component) == 0)
+	{
+		return;
+	}
+
+	Component->OnComponentHit.RemoveDynamic(this, &UDoodleContactSubsystem::HandleComponentHit);
+
+	PendingContacts.RemoveAllSwap([Component](const FPendingContact& Contact)
+	{
+		return Contact.Hazard.Get() == Component;
+	}, EAllowShrinking::No);
+}
+
+void UDoodleContactSubsystem::HandleComponentHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+{
+	INC_DWORD_STAT(STAT_DoodleHitEvents);
+	CSV_CUSTOM_STAT(DoodleJump, HitEvents, 1, ECsvCustomStatOp::Accumulate);
+
+	// Only pawns block the hazard profile - anything else is a stray physics contact
+	if (!OtherComp || OtherComp->GetCollisionObjectType() != ECC_Pawn)
+	{
+		return;
+	}
+
+	// Resting or sweeping characters report the same pair several times a frame
+	for (FPendingContact& Contact : PendingContacts)
+	{
+		if (Contact.Hazard.Get() == HitComponent && Contact.Character.Get() == OtherActor)
+		{
+			Contact.NumHits++;
+			return;
+		}
+	}
+
+	ADoodleCharacter* Character = Cast<ADoodleCharacter>(OtherActor);
+	if (!Character)
+	{
+		return;
+	}
+
+	FPendingContact& Contact = PendingContacts.AddDefaulted_GetRef();
+	Contact.Hazard = HitComponent;
+	Contact.Character = Character;
+	Contact.Hit = Hit;
+	Contact.NumHits = 1;
+}
+
+void UDoodleContactSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_DoodleContacts);
+	CSV_SCOPED_TIMING_STAT(DoodleJump, Contacts);
+
+	Super::Tick(DeltaTime);
+
+	SET_DWORD_STAT(STAT_DoodleContactPairs, PendingContacts.Num());
+	CSV_CUSTOM_STAT(DoodleJump, ContactPairs, PendingContacts.Num(), ECsvCustomStatOp::Set);
+	if (PendingContacts.Num() == 0)
+	{
+		return;
+	}
+
+	// Hazard logic may register, unregister or hit again - dispatch from a stable copy
+	Swap(PendingContacts, DispatchingContacts);
+	PendingContacts.Reset();
+
+	for (const FPendingContact& Pending : DispatchingContacts)
+	{
+		UPrimitiveComponent* Hazard = Pending.Hazard.Get();
+		ADoodleCharacter* Character = Pending.Character.Get();
+		if (!Hazard || !Character)
+		{
+			continue;
+		}
+
+		const FDoodleContactDelegate* OnContact = Hazards.Find(TObjectKey<UPrimitiveComponent>(Hazard));
+		if (!OnContact || !OnContact->IsBound())
+		{
+			continue;
+		}
+
+		FDoodleContact Contact = Classify(Hazard, Character, Pending.Hit);
+		Contact.NumHits = Pending.NumHits;
+		OnContact->Execute(Contact);
+	}
+
+	DispatchingContacts.Reset();
+}
+
+FDoodleContact UDoodleContactSubsystem::Classify(UPrimitiveComponent* HazardComponent, ADoodleCharacter* Character, const FHitResult& Hit)
+{
+	FDoodleContact Contact;
+	Contact.Character = Character;
+	Contact.HazardComponent = HazardComponent;
+	Contact.ImpactPoint = Hit.ImpactPoint;
+	Contact.CharacterVelocity = Character->GetVelocity();
+
+	const FVector CharacterLocation = Character->GetActorLocation();
+	const AActor* HazardActor = HazardComponent->GetOwner();
+	Contact.ToCharacter = (CharacterLocation - (HazardActor ? HazardActor->GetActorLocation() : HazardComponent->GetComponentLocation())).GetSafeNormal();
+
+	// The hit is reported from the mover's side - orient the normal away from the hazard
+	Contact.Normal = Hit.Normal;
+	if (FVector::DotProduct(Contact.Normal, CharacterLocation - Hit.ImpactPoint) < 0.0)
+	{
+		Contact.Normal = -Contact.Normal;
+	}
+
+	if (Contact.Normal.Z > DoodleContact::TopBottomNormalZ)
+	{
+		Contact.Side = EDoodleContactSide::Top;
+	}
+	else if (Contact.Normal.Z < -DoodleContact::TopBottomNormalZ)
+	{
+		Contact.Side = EDoodleContactSide::Bottom;
+	}
+	else
+	{
+		Contact.Side = EDoodleContactSide::Side;
+	}
+
+	return Contact;
+}
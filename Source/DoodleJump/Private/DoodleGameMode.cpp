@@ -1,8 +1,41 @@
 #include "DoodleGameMode.h"
 #include "DoodleCharacter.h"
+#include "DoodleGhost.h"
+#include "DoodleTowerGenerator.h"
+#include "Kismet/GameplayStatics.h"
 
 ADoodleGameMode::ADoodleGameMode()
 {
 	DefaultPawnClass = nullptr;
+	EndlessStartDrop = 150.0f;
+	GhostClass = ADoodleGhost::StaticClass();
+}
+
+void ADoodleGameMode::StartPlay()
+{
+	if (EndlessTowerGeneratorClass && UGameplayStatics::HasOption(OptionsString, TEXT("Endless")))
+	{
+		const AActor* PlayerStart = FindPlayerStart(nullptr);
+		const FVector StartLocation = PlayerStart ? PlayerStart->GetActorLocation() : FVector::ZeroVector;
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		GetWorld()->SpawnActor<ADoodleTowerGenerator>(EndlessTowerGeneratorClass, StartLocation - FVector(0.0f, 0.0f, EndlessStartDrop), FRotator::ZeroRotator, SpawnParams);
+	}
+
+	const FString GhostName = UGameplayStatics::ParseOption(OptionsString, TEXT("Ghost"));
+	if (GhostClass && !GhostName.IsEmpty())
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.bDeferConstruction = true;
+		if (ADoodleGhost* Ghost = GetWorld()->SpawnActor<ADoodleGhost>(GhostClass, FTransform::Identity, SpawnParams))
+		{
+			Ghost->GhostName = GhostName;
+			Ghost->FinishSpawning(FTransform::Identity);
+		}
+	}
+
+	Super::StartPlay();
 }
 
@@ -0,0 +1,302 @@
+#include "DoodleGhost.h"
+#include "DoodleGhostRecorderComponent.h"
+#include "DoodleJump.h"
+#include "DoodleWorldResetSubsystem.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "HAL/FileManager.h"
+#include "UObject/ConstructorHelpers.h"
+
+ADoodleGhost::ADoodleGhost()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	GhostMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("GhostMesh"));
+	RootComponent = GhostMesh;
+	GhostMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	GhostMesh->SetGenerateOverlapEvents(false);
+	GhostMesh->SetCastShadow(false);
+
+	// Visible without a Blueprint: an engine cylinder the size of the default character capsule
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> DefaultMesh(TEXT("/Engine/BasicShapes/Cylinder.Cylinder"));
+	if (DefaultMesh.Succeeded())
+	{
+		GhostMesh->SetStaticMesh(DefaultMesh.Object);
+		GhostMesh->SetRelativeScale3D(FVector(0.68f, 0.68f, 1.76f));
+	}
+
+	bLoop = false;
+	DataOffset = 0;
+	NumSamples = 0;
+	SkipRemaining = 0;
+	PendingFlags = DoodleGhost::RecordEnd;
+	SampleTime = 0.0f;
+	PreviousLocation = FVector::ZeroVector;
+	CurrentLocation = FVector::ZeroVector;
+	PreviousYaw = 0.0f;
+	CurrentYaw = 0.0f;
+}
+
+void ADoodleGhost::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!GhostName.IsEmpty())
+	{
+		Play(GhostName);
+	}
+
+	if (UDoodleWorldResetSubsystem* Reset = GetWorld()->GetSubsystem<UDoodleWorldResetSubsystem>())
+	{
+		Reset->RegisterResettable(this, FSimpleDelegate::CreateUObject(this, &ADoodleGhost::ResetGhost));
+	}
+}
+
+void ADoodleGhost::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Stop();
+
+	if (UDoodleWorldResetSubsystem* Reset = GetWorld()->GetSubsystem<UDoodleWorldResetSubsystem>())
+	{
+		Reset->UnregisterResettable(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool ADoodleGhost::Play(const FString& InGhostName)
+{
+	Stop();
+	GhostName = InGhostName;
+
+	const FString FilePath = UDoodleGhostRecorderComponent::GetGhostPath(GhostName);
+	Reader.Reset(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Reader)
+	{
+		UE_LOG(LogDoodleJump, Warning, TEXT("Ghost: could not open '%s'"), *FilePath);
+		return false;
+	}
+
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	uint16 SampleRate = 0;
+	float GravityZ = 0.0f;
+	FString MapName;
+	*Reader << Magic << Version << SampleRate << GravityZ << NumSamples << MapName;
+
+	if (Reader->IsError() || Magic != DoodleGhost::FileMagic || Version != DoodleGhost::FileVersion || SampleRate == 0)
+	{
+		UE_LOG(LogDoodleJump, Warning, TEXT("Ghost: '%s' is not a version %d ghost file"), *FilePath, DoodleGhost::FileVersion);
+		Reader.Reset();
+		return false;
+	}
+
+	if (MapName != UWorld::RemovePIEPrefix(GetWorld()->GetMapName()))
+	{
+		UE_LOG(LogDoodleJump, Warning, TEXT("Ghost: '%s' was recorded on %s"), *GhostName, *MapName);
+	}
+
+	DataOffset = Reader->Tell();
+	Track.SampleInterval = 1.0 / SampleRate;
+	Track.GravityZ = GravityZ;
+
+	Rewind();
+	SetActorHiddenInGame(false);
+	SetActorTickEnabled(true);
+	return true;
+}
+
+void ADoodleGhost::Stop()
+{
+	if (Reader)
+	{
+		Reader->Close();
+		Reader.Reset();
+	}
+
+	SetActorTickEnabled(false);
+}
+
+void ADoodleGhost::Rewind()
+{
+	Reader->Seek(DataOffset);
+
+	const double SampleInterval = Track.SampleInterval;
+	const double GravityZ = Track.GravityZ;
+	Track = DoodleGhost::FTrack();
+	Track.SampleInterval = SampleInterval;
+	Track.GravityZ = GravityZ;
+
+	SampleTime = 0.0f;
+
+	// The stream opens with a keyframe
+	if (ReadRecordHeader() && AdvanceSample())
+	{
+		PreviousLocation = CurrentLocation;
+		PreviousYaw = CurrentYaw;
+		SetActorLocationAndRotation(CurrentLocation, FRotator(0.0f, CurrentYaw, 0.0f));
+	}
+}
+
+void ADoodleGhost::ResetGhost()
+{
+	if (Reader)
+	{
+		Rewind();
+	}
+	else if (!GhostName.IsEmpty())
+	{
+		Play(GhostName);
+	}
+}
+
+void ADoodleGhost::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!Reader)
+	{
+		return;
+	}
+
+	SampleTime += DeltaTime;
+	while (SampleTime >= Track.SampleInterval)
+	{
+		SampleTime -= Track.SampleInterval;
+		PreviousLocation = CurrentLocation;
+		PreviousYaw = CurrentYaw;
+
+		if (!AdvanceSample())
+		{
+			if (bLoop)
+			{
+				Rewind();
+				return;
+			}
+
+			Stop();
+			SetActorHiddenInGame(true);
+			return;
+		}
+	}
+
+	// Samples are far apart compared to frames - interpolate between the last two
+	const float Alpha = static_cast<float>(SampleTime / Track.SampleInterval);
+	const FVector Location = FMath::Lerp(PreviousLocation, CurrentLocation, Alpha);
+	const float Yaw = PreviousYaw + FRotator::NormalizeAxis(CurrentYaw - PreviousYaw) * Alpha;
+	SetActorLocationAndRotation(Location, FRotator(0.0f, Yaw, 0.0f));
+}
+
+bool ADoodleGhost::AdvanceSample()
+{
+	using namespace DoodleGhost;
+
+	if (SkipRemaining > 0)
+	{
+		SkipRemaining--;
+		Track.Predict();
+	}
+	else
+	{
+		if (PendingFlags == RecordEnd)
+		{
+			return false;
+		}
+
+		// Mirrors UDoodleGhostRecorderComponent::RecordSample
+		bool bValid = true;
+		if (PendingFlags & RecordKeyframe)
+		{
+			FSample Sample;
+			bValid = ReadSigned(Sample.Position.X) && ReadSigned(Sample.Position.Y) && ReadSigned(Sample.Position.Z)
+				&& ReadSigned(Sample.VelocityZ) && ReadByte(Sample.Yaw) && ReadByte(Sample.State);
+			Track.ApplyKeyframe(Sample);
+		}
+		else
+		{
+			Track.Predict();
+
+			if (bValid && (PendingFlags & RecordXY))
+			{
+				FIntPoint Correction;
+				bValid = ReadSigned(Correction.X) && ReadSigned(Correction.Y);
+				Track.ApplyXY(Correction);
+			}
+			if (bValid && (PendingFlags & RecordArc))
+			{
+				int32 ZError = 0;
+				int32 VelocityZ = 0;
+				bValid = ReadSigned(ZError) && ReadSigned(VelocityZ);
+				Track.StartArc(Track.Position.Z + ZError, VelocityZ);
+			}
+			if (bValid && (PendingFlags & RecordYaw))
+			{
+				bValid = ReadByte(Track.Yaw);
+			}
+			if (bValid && (PendingFlags & RecordState))
+			{
+				bValid = ReadByte(Track.State);
+			}
+		}
+
+		if (!bValid || !ReadRecordHeader())
+		{
+			UE_LOG(LogDoodleJump, Warning, TEXT("Ghost: '%s' is truncated"), *GhostName);
+			SkipRemaining = 0;
+			PendingFlags = RecordEnd;
+		}
+	}
+
+	CurrentLocation = Track.GetLocation();
+	CurrentYaw = FRotator::DecompressAxisFromByte(Track.Yaw);
+	return true;
+}
+
+bool ADoodleGhost::ReadRecordHeader()
+{
+	return ReadVarInt(SkipRemaining) && ReadByte(PendingFlags);
+}
+
+bool ADoodleGhost::ReadByte(uint8& Byte)
+{
+	if (Reader->AtEnd())
+	{
+		return false;
+	}
+
+	Reader->Serialize(&Byte, 1);
+	return !Reader->IsError();
+}
+
+bool ADoodleGhost::ReadVarInt(uint32& Value)
+{
+	Value = 0;
+	for (int32 Shift = 0; Shift < 35; Shift += 7)
+	{
+		uint8 Byte = 0;
+		if (!ReadByte(Byte))
+		{
+			return false;
+		}
+
+		Value |= static_cast<uint32>(Byte & 0x7F) << Shift;
+		if (!(Byte & 0x80))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ADoodleGhost::ReadSigned(int32& Value)
+{
+	uint32 Encoded = 0;
+	if (!ReadVarInt(Encoded))
+	{
+		return false;
+	}
+
+	Value = DoodleGhost::UnZigZag(Encoded);
+	return true;
+}
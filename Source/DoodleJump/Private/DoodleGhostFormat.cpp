@@ -0,0 +1,54 @@
+#include "DoodleGhostFormat.h"
+
+namespace DoodleGhost
+{
+	double FTrack::ArcHeight(double Samples) const
+	{
+		const double Time = Samples * SampleInterval;
+		const double Gravity = (State & Frozen) ? 0.0 : GravityZ;
+		return ArcZ + (ArcVelocity * VelocityUnit * Time + 0.5 * Gravity * Time * Time) / PositionUnit;
+	}
+
+	void FTrack::Predict()
+	{
+		Position.X += Step.X;
+		Position.Y += Step.Y;
+		ArcSamples++;
+		Position.Z = FMath::RoundToInt(ArcHeight(ArcSamples));
+	}
+
+	void FTrack::ApplyXY(const FIntPoint& Correction)
+	{
+		Position.X += Correction.X;
+		Position.Y += Correction.Y;
+		Step += Correction;
+	}
+
+	void FTrack::StartArc(int32 Z, int32 Velocity)
+	{
+		ArcZ = Z;
+		ArcVelocity = Velocity;
+		ArcSamples = 0;
+		Position.Z = Z;
+	}
+
+	void FTrack::ApplyKeyframe(const FSample& Sample)
+	{
+		// Keeps the step - a keyframe only resets accumulated drift
+		Position.X = Sample.Position.X;
+		Position.Y = Sample.Position.Y;
+		StartArc(Sample.Position.Z, Sample.VelocityZ);
+		Yaw = Sample.Yaw;
+		State = Sample.State;
+	}
+
+	void WriteVarInt(TArray<uint8>& Out, uint32 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Out.Add(static_cast<uint8>(Value) | 0x80);
+			Value >>= 7;
+		}
+		Out.Add(static_cast<uint8>(Value));
+	}
+}
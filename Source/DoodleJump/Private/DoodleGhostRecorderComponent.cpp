@@ -0,0 +1,289 @@
+#include "DoodleGhostRecorderComponent.h"
+#include "DoodleCharacter.h"
+#include "DoodleMovementComponent.h"
+#include "DoodleJump.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+
+UDoodleGhostRecorderComponent::UDoodleGhostRecorderComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	// Sample after the character has moved this frame
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+
+	SampleRate = 10;
+
+	bRecording = false;
+	NumSamples = 0;
+	PendingSkip = 0;
+	SampleAccumulator = 0.0f;
+	RecordingStartTime = 0.0;
+	PreviousLocation = FVector::ZeroVector;
+	CurrentLocation = FVector::ZeroVector;
+	PreviousVelocityZ = 0.0;
+	CurrentVelocityZ = 0.0;
+	PreviousYaw = 0.0f;
+	CurrentYaw = 0.0f;
+}
+
+FString UDoodleGhostRecorderComponent::GetGhostPath(const FString& GhostName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("Ghosts") / (GhostName + TEXT(".ghost"));
+}
+
+void UDoodleGhostRecorderComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	FString GhostName;
+	if (FParse::Value(FCommandLine::Get(), TEXT("RecordGhost="), GhostName) && Cast<APawn>(GetOwner()) && Cast<APawn>(GetOwner())->IsPlayerControlled())
+	{
+		StartRecording(GhostName);
+	}
+}
+
+void UDoodleGhostRecorderComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopRecording();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UDoodleGhostRecorderComponent::StartRecording(const FString& GhostName)
+{
+	const ADoodleCharacter* Character = Cast<ADoodleCharacter>(GetOwner());
+	if (!Character || GhostName.IsEmpty())
+	{
+		return;
+	}
+
+	RecordingName = GhostName;
+	bRecording = true;
+	NumSamples = 0;
+	PendingSkip = 0;
+	SampleAccumulator = 0.0f;
+	RecordingStartTime = GetWorld()->GetTimeSeconds();
+
+	Track = DoodleGhost::FTrack();
+	Track.SampleInterval = 1.0 / FMath::Max(SampleRate, 1);
+	Track.GravityZ = Character->GetDoodleMovement() ? Character->GetDoodleMovement()->GetGravityZ() : GetWorld()->GetGravityZ();
+
+	// A few minutes of play without growing
+	Stream.Reset();
+	Stream.Reserve(4096);
+
+	// The previous and the current frame both start at the character's state now
+	CaptureFrame(Character, 0.0f);
+	CaptureFrame(Character, 0.0f);
+	RecordSample(Character, 1.0f);
+	SetComponentTickEnabled(true);
+}
+
+bool UDoodleGhostRecorderComponent::StopRecording()
+{
+	if (!bRecording)
+	{
+		return false;
+	}
+
+	bRecording = false;
+	SetComponentTickEnabled(false);
+
+	// Trailing predicted samples, then the terminator
+	DoodleGhost::WriteVarInt(Stream, PendingSkip);
+	Stream.Add(DoodleGhost::RecordEnd);
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = DoodleGhost::FileMagic;
+	uint16 Version = DoodleGhost::FileVersion;
+	uint16 Rate = static_cast<uint16>(FMath::Max(SampleRate, 1));
+	float GravityZ = static_cast<float>(Track.GravityZ);
+	FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	Writer << Magic << Version << Rate << GravityZ << NumSamples << MapName;
+	Writer.Serialize(Stream.GetData(), Stream.Num());
+
+	const FString FilePath = GetGhostPath(RecordingName);
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+	if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+	{
+		UE_LOG(LogDoodleJump, Error, TEXT("Ghost: could not write '%s'"), *FilePath);
+		return false;
+	}
+
+	// Measured against the world clock, so the figure is the real file growth per minute of play
+	const double Minutes = (GetWorld()->GetTimeSeconds() - RecordingStartTime) / 60.0;
+	UE_LOG(LogDoodleJump, Log, TEXT("Ghost: %u samples over %.2f min, %d bytes on disk (%.0f bytes/min) - %s"),
+		NumSamples, Minutes, Bytes.Num(), Minutes > 0.0 ? Bytes.Num() / Minutes : 0.0, *FilePath);
+	return true;
+}
+
+void UDoodleGhostRecorderComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const ADoodleCharacter* Character = Cast<ADoodleCharacter>(GetOwner());
+	if (!bRecording || !Character)
+	{
+		return;
+	}
+
+	CaptureFrame(Character, DeltaTime);
+
+	// Fixed step: each sample is placed at its own time inside this frame, several per frame at very low frame rates
+	SampleAccumulator += DeltaTime;
+	while (SampleAccumulator >= Track.SampleInterval)
+	{
+		SampleAccumulator -= Track.SampleInterval;
+		RecordSample(Character, DeltaTime > 0.0f ? 1.0f - SampleAccumulator / DeltaTime : 1.0f);
+	}
+}
+
+void UDoodleGhostRecorderComponent::CaptureFrame(const ADoodleCharacter* Character, float DeltaTime)
+{
+	const UDoodleMovementComponent* Movement = Character->GetDoodleMovement();
+
+	PreviousLocation = CurrentLocation;
+	PreviousVelocityZ = CurrentVelocityZ;
+	PreviousYaw = CurrentYaw;
+
+	CurrentLocation = Character->GetActorLocation();
+	CurrentYaw = Character->GetActorRotation().Yaw;
+
+	// The movement integrates velocity before position every frame, which runs half a frame of gravity ahead of the exact parabola
+	CurrentVelocityZ = Movement ? Movement->Velocity.Z + 0.5 * Track.GravityZ * DeltaTime : 0.0;
+}
+
+DoodleGhost::FSample UDoodleGhostRecorderComponent::Capture(const ADoodleCharacter* Character, float Alpha) const
+{
+	const FVector Location = FMath::Lerp(PreviousLocation, CurrentLocation, Alpha);
+	const float Yaw = PreviousYaw + FRotator::NormalizeAxis(CurrentYaw - PreviousYaw) * Alpha;
+	const UDoodleMovementComponent* Movement = Character->GetDoodleMovement();
+
+	DoodleGhost::FSample Sample;
+	Sample.Position = FIntVector(
+		FMath::RoundToInt(Location.X / DoodleGhost::PositionUnit),
+		FMath::RoundToInt(Location.Y / DoodleGhost::PositionUnit),
+		FMath::RoundToInt(Location.Z / DoodleGhost::PositionUnit));
+
+	Sample.VelocityZ = FMath::RoundToInt(FMath::Lerp(PreviousVelocityZ, CurrentVelocityZ, static_cast<double>(Alpha)) / DoodleGhost::VelocityUnit);
+	Sample.Yaw = FRotator::CompressAxisToByte(Yaw);
+
+	if (Movement)
+	{
+		switch (Movement->GetDoodleState())
+		{
+		case EDoodleMovementState::Frozen:
+			Sample.State |= DoodleGhost::Frozen;
+			Sample.VelocityZ = 0;
+			break;
+		case EDoodleMovementState::KnockedBack:
+			Sample.State |= DoodleGhost::KnockedBack;
+			break;
+		default:
+			break;
+		}
+
+		if (Movement->Velocity.Z > Movement->JumpZVelocity * 1.05f)
+		{
+			Sample.State |= DoodleGhost::Boosted;
+		}
+	}
+
+	return Sample;
+}
+
+void UDoodleGhostRecorderComponent::RecordSample(const ADoodleCharacter* Character, float Alpha)
+{
+	using namespace DoodleGhost;
+
+	const FSample Sample = Capture(Character, Alpha);
+	const bool bKeyframe = NumSamples % KeyframeInterval == 0;
+	NumSamples++;
+
+	// What playback will predict for this sample
+	if (!bKeyframe)
+	{
+		Track.Predict();
+	}
+
+	uint8 Flags = 0;
+	const FIntPoint XYError(Sample.Position.X - Track.Position.X, Sample.Position.Y - Track.Position.Y);
+	const int32 ZError = Sample.Position.Z - Track.Position.Z;
+
+	if (bKeyframe)
+	{
+		Flags = RecordKeyframe;
+	}
+	else
+	{
+		if (FMath::Abs(XYError.X) > XYTolerance || FMath::Abs(XYError.Y) > XYTolerance)
+		{
+			Flags |= RecordXY;
+		}
+		if (FMath::Abs(ZError) > ZTolerance || Sample.State != Track.State)
+		{
+			Flags |= RecordArc;
+		}
+		if (Sample.Yaw != Track.Yaw)
+		{
+			Flags |= RecordYaw;
+		}
+		if (Sample.State != Track.State)
+		{
+			Flags |= RecordState;
+		}
+	}
+
+	if (Flags == 0)
+	{
+		PendingSkip++;
+		return;
+	}
+
+	WriteVarInt(Stream, PendingSkip);
+	Stream.Add(Flags);
+	PendingSkip = 0;
+
+	// Payload, mirrored into the track exactly as playback will apply it
+	if (Flags & RecordKeyframe)
+	{
+		WriteVarInt(Stream, ZigZag(Sample.Position.X));
+		WriteVarInt(Stream, ZigZag(Sample.Position.Y));
+		WriteVarInt(Stream, ZigZag(Sample.Position.Z));
+		WriteVarInt(Stream, ZigZag(Sample.VelocityZ));
+		Stream.Add(Sample.Yaw);
+		Stream.Add(Sample.State);
+		Track.ApplyKeyframe(Sample);
+		return;
+	}
+
+	if (Flags & RecordXY)
+	{
+		WriteVarInt(Stream, ZigZag(XYError.X));
+		WriteVarInt(Stream, ZigZag(XYError.Y));
+		Track.ApplyXY(XYError);
+	}
+	if (Flags & RecordArc)
+	{
+		WriteVarInt(Stream, ZigZag(ZError));
+		WriteVarInt(Stream, ZigZag(Sample.VelocityZ));
+		Track.StartArc(Sample.Position.Z, Sample.VelocityZ);
+	}
+	if (Flags & RecordYaw)
+	{
+		Stream.Add(Sample.Yaw);
+		Track.Yaw = Sample.Yaw;
+	}
+	if (Flags & RecordState)
+	{
+		Stream.Add(Sample.State);
+		Track.State = Sample.State;
+	}
+}
@@ -0,0 +1,269 @@
+#include "DoodleHeightIndexSubsystem.h"
+#include "DoodleJump.h"
+#include "Engine/World.h"
+
+UDoodleHeightIndexSubsystem::UDoodleHeightIndexSubsystem()
+{
+	BucketHeight = 400.0f;
+
+	FirstBucket = 0;
+	MaxHalfHeight = 0.0f;
+}
+
+bool UDoodleHeightIndexSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDoodleHeightIndexSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	BucketHeight = FMath::Max(BucketHeight, 1.0f);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UDoodleHeightIndexSubsystem::HandlePostActorTick);
+}
+
+void UDoodleHeightIndexSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	Actors.Empty();
+	Items.Empty();
+	Categories.Empty();
+	Centers.Empty();
+	Extents.Empty();
+	BucketOf.Empty();
+	BucketSlots.Empty();
+	ActorOffsets.Empty();
+	MovingSlots.Empty();
+	MovingHandles.Empty();
+	FreeHandles.Empty();
+	Buckets.Empty();
+
+	Super::Deinitialize();
+}
+
+int32 UDoodleHeightIndexSubsystem::AllocateHandle()
+{
+	if (FreeHandles.Num() > 0)
+	{
+		return FreeHandles.Pop(EAllowShrinking::No);
+	}
+
+	Actors.AddDefaulted();
+	Items.Add(INDEX_NONE);
+	Categories.Add(0);
+	Centers.AddZeroed();
+	Extents.AddZeroed();
+	BucketOf.Add(0);
+	BucketSlots.Add(INDEX_NONE);
+	ActorOffsets.AddZeroed();
+	MovingSlots.Add(INDEX_NONE);
+	return Categories.Num() - 1;
+}
+
+int32 UDoodleHeightIndexSubsystem::AddActor(AActor* Actor, EDoodleHeightCategory Category, bool bMoves)
+{
+	if (!Actor)
+	{
+		return INDEX_NONE;
+	}
+
+	FVector Origin, BoxExtent;
+	Actor->GetActorBounds(true, Origin, BoxExtent);
+
+	const int32 Handle = AddBounds(Actor, INDEX_NONE, FBox::BuildAABB(Origin, BoxExtent), Category);
+	if (bMoves)
+	{
+		ActorOffsets[Handle] = FVector3f(Origin - Actor->GetActorLocation());
+		MovingSlots[Handle] = MovingHandles.Add(Handle);
+	}
+	return Handle;
+}
+
+int32 UDoodleHeightIndexSubsystem::AddBounds(AActor* Owner, int32 Item, const FBox& Bounds, EDoodleHeightCategory Category)
+{
+	const int32 Handle = AllocateHandle();
+	Actors[Handle] = Owner;
+	Items[Handle] = Item;
+	Categories[Handle] = Category;
+	Centers[Handle] = FVector3f(Bounds.GetCenter());
+	Extents[Handle] = FVector3f(Bounds.GetExtent());
+	MaxHalfHeight = FMath::Max(MaxHalfHeight, Extents[Handle].Z);
+
+	InsertIntoBucket(Handle);
+	return Handle;
+}
+
+void UDoodleHeightIndexSubsystem::Refresh(int32 Handle)
+{
+	AActor* Actor = GetActor(Handle);
+	if (!Actor || Items[Handle] != INDEX_NONE)
+	{
+		return;
+	}
+
+	FVector Origin, BoxExtent;
+	Actor->GetActorBounds(true, Origin, BoxExtent);
+
+	Extents[Handle] = FVector3f(BoxExtent);
+	MaxHalfHeight = FMath::Max(MaxHalfHeight, Extents[Handle].Z);
+	ActorOffsets[Handle] = FVector3f(Origin - Actor->GetActorLocation());
+	SetCenter(Handle, FVector3f(Origin));
+}
+
+void UDoodleHeightIndexSubsystem::Remove(int32& Handle)
+{
+	if (!Categories.IsValidIndex(Handle) || Categories[Handle] == 0)
+	{
+		Handle = INDEX_NONE;
+		return;
+	}
+
+	RemoveFromBucket(Handle);
+
+	const int32 MovingSlot = MovingSlots[Handle];
+	if (MovingSlot != INDEX_NONE)
+	{
+		MovingHandles.RemoveAtSwap(MovingSlot, EAllowShrinking::No);
+		if (MovingHandles.IsValidIndex(MovingSlot))
+		{
+			MovingSlots[MovingHandles[MovingSlot]] = MovingSlot;
+		}
+		MovingSlots[Handle] = INDEX_NONE;
+	}
+
+	Actors[Handle].Reset();
+	Items[Handle] = INDEX_NONE;
+	Categories[Handle] = 0;
+	FreeHandles.Add(Handle);
+
+	Handle = INDEX_NONE;
+}
+
+FBox UDoodleHeightIndexSubsystem::GetBounds(int32 Handle) const
+{
+	if (!Categories.IsValidIndex(Handle) || Categories[Handle] == 0)
+	{
+		return FBox(ForceInit);
+	}
+
+	return FBox::BuildAABB(FVector(Centers[Handle]), FVector(Extents[Handle]));
+}
+
+void UDoodleHeightIndexSubsystem::InsertIntoBucket(int32 Handle)
+{
+	const int32 Bucket = BucketNumber(Centers[Handle].Z);
+
+	// Grow the bucket range to cover the entry - downwards is rare, the tower only grows up
+	if (Buckets.Num() == 0)
+	{
+		FirstBucket = Bucket;
+	}
+	else if (Bucket < FirstBucket)
+	{
+		Buckets.InsertDefaulted(0, FirstBucket - Bucket);
+		FirstBucket = Bucket;
+	}
+	if (Bucket - FirstBucket >= Buckets.Num())
+	{
+		Buckets.SetNum(Bucket - FirstBucket + 1);
+	}
+
+	BucketOf[Handle] = Bucket;
+	BucketSlots[Handle] = Buckets[Bucket - FirstBucket].Add(Handle);
+}
+
+void UDoodleHeightIndexSubsystem::RemoveFromBucket(int32 Handle)
+{
+	TArray<int32>& Bucket = Buckets[BucketOf[Handle] - FirstBucket];
+	const int32 Slot = BucketSlots[Handle];
+
+	Bucket.RemoveAtSwap(Slot, EAllowShrinking::No);
+	if (Bucket.IsValidIndex(Slot))
+	{
+		BucketSlots[Bucket[Slot]] = Slot;
+	}
+	BucketSlots[Handle] = INDEX_NONE;
+}
+
+void UDoodleHeightIndexSubsystem::SetCenter(int32 Handle, const FVector3f& Center)
+{
+	Centers[Handle] = Center;
+
+	// Most moves stay within the bucket - only crossing one touches the bucket arrays
+	if (BucketNumber(Center.Z) != BucketOf[Handle])
+	{
+		RemoveFromBucket(Handle);
+		InsertIntoBucket(Handle);
+	}
+}
+
+int32 UDoodleHeightIndexSubsystem::FindNearestBelow(const FVector& Point, float Radius, float MaxDrop, uint8 CategoryMask) const
+{
+	if (Buckets.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const double MinTop = Point.Z - MaxDrop;
+	int32 Best = INDEX_NONE;
+	double BestTop = MinTop;
+
+	// Top down, so the walk can stop as soon as no lower bucket can hold anything higher than the best so far
+	const int32 First = FMath::Min(BucketNumber(Point.Z + MaxHalfHeight) - FirstBucket, Buckets.Num() - 1);
+	const int32 Last = FMath::Max(BucketNumber(MinTop - MaxHalfHeight) - FirstBucket, 0);
+	for (int32 Bucket = First; Bucket >= Last; --Bucket)
+	{
+		const double HighestTopInBucket = double(Bucket + FirstBucket + 1) * BucketHeight + MaxHalfHeight;
+		if (Best != INDEX_NONE && HighestTopInBucket < BestTop)
+		{
+			break;
+		}
+
+		for (const int32 Handle : Buckets[Bucket])
+		{
+			if (!(Categories[Handle] & CategoryMask))
+			{
+				continue;
+			}
+
+			const FVector3f& Center = Centers[Handle];
+			const FVector3f& Extent = Extents[Handle];
+			const double Top = Center.Z + Extent.Z;
+			if (Top > Point.Z || Top < BestTop
+				|| FMath::Abs(Point.X - Center.X) > Extent.X + Radius
+				|| FMath::Abs(Point.Y - Center.Y) > Extent.Y + Radius)
+			{
+				continue;
+			}
+
+			Best = Handle;
+			BestTop = Top;
+		}
+	}
+
+	return Best;
+}
+
+void UDoodleHeightIndexSubsystem::HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_DoodleHeightIndex);
+	CSV_SCOPED_TIMING_STAT(DoodleJump, HeightIndex);
+
+	for (const int32 Handle : MovingHandles)
+	{
+		if (const AActor* Actor = Actors[Handle].Get())
+		{
+			SetCenter(Handle, FVector3f(Actor->GetActorLocation()) + ActorOffsets[Handle]);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_DoodleHeightIndexEntries, GetNumEntries());
+	SET_DWORD_STAT(STAT_DoodleHeightIndexMoving, MovingHandles.Num());
+}
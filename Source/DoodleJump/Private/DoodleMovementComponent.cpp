@@ -0,0 +1,326 @@
+#include "DoodleMovementComponent.h"
+#include "DoodleBenchmark.h"
+#include "DoodleJump.h"
+#include "DoodleTrace.h"
+#include "MovingPlatformSubsystem.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/Controller.h"
+
+UDoodleMovementComponent::UDoodleMovementComponent()
+{
+	KnockbackDuration = 0.5f;
+
+	DoodleState = EDoodleMovementState::Normal;
+	StateTimeRemaining = 0.0f;
+	FreezeAttachmentActor = nullptr;
+	FreezeRelativeOffset = FVector::ZeroVector;
+	LatchedMoveInput = FVector2D::ZeroVector;
+	bHasLatchedMoveInput = false;
+	bConsumedMoveInput = false;
+	bFreezeCarried = false;
+}
+
+void UDoodleMovementComponent::SetDefaultMovementMode()
+{
+	SetMovementMode(MOVE_Custom, CMOVE_Doodle);
+}
+
+void UDoodleMovementComponent::StartNewPhysics(float DeltaTime, int32 Iterations)
+{
+	// Doodle mode is the only locomotion mode - engine paths that drop into walking or falling are routed back
+	if (MovementMode == MOVE_Walking || MovementMode == MOVE_NavWalking || MovementMode == MOVE_Falling)
+	{
+		SetMovementMode(MOVE_Custom, CMOVE_Doodle);
+	}
+
+	Super::StartNewPhysics(DeltaTime, Iterations);
+}
+
+bool UDoodleMovementComponent::IsFalling() const
+{
+	// Report airborne while bouncing so animation and gameplay queries keep working
+	return Super::IsFalling() || (IsDoodling() && !IsFrozen());
+}
+
+bool UDoodleMovementComponent::HandlePendingLaunch()
+{
+	if (!IsDoodling())
+	{
+		return Super::HandlePendingLaunch();
+	}
+
+	// LaunchCharacter sets the velocity but must not leave doodle mode
+	if (!PendingLaunchVelocity.IsZero() && HasValidData())
+	{
+		Velocity = PendingLaunchVelocity;
+		PendingLaunchVelocity = FVector::ZeroVector;
+		return true;
+	}
+
+	return false;
+}
+
+void UDoodleMovementComponent::LatchMoveInput(const FVector2D& Value)
+{
+	LatchedMoveInput = Value;
+	bHasLatchedMoveInput = true;
+}
+
+FVector UDoodleMovementComponent::ConsumeInputVector()
+{
+	FVector Input = Super::ConsumeInputVector();
+	if (!bHasLatchedMoveInput)
+	{
+		bConsumedMoveInput = !Input.IsNearlyZero();
+		return Input;
+	}
+	bHasLatchedMoveInput = false;
+
+	const AController* Controller = PawnOwner ? PawnOwner->GetController() : nullptr;
+	if (Controller && !PawnOwner->IsMoveInputIgnored())
+	{
+		const FRotationMatrix YawMatrix(FRotator(0.0f, Controller->GetControlRotation().Yaw, 0.0f));
+		Input += YawMatrix.GetUnitAxis(EAxis::X) * LatchedMoveInput.Y + YawMatrix.GetUnitAxis(EAxis::Y) * LatchedMoveInput.X;
+	}
+	LatchedMoveInput = FVector2D::ZeroVector;
+
+	bConsumedMoveInput = !Input.IsNearlyZero();
+	return Input;
+}
+
+void UDoodleMovementComponent::PhysCustom(float DeltaTime, int32 Iterations)
+{
+	if (CustomMovementMode == CMOVE_Doodle)
+	{
+		PhysDoodle(DeltaTime, Iterations);
+		return;
+	}
+
+	Super::PhysCustom(DeltaTime, Iterations);
+}
+
+void UDoodleMovementComponent::PhysDoodle(float DeltaTime, int32 Iterations)
+{
+	DOODLE_BENCHMARK_TICK_SCOPE("UDoodleMovementComponent");
+	SCOPE_CYCLE_COUNTER(STAT_DoodleMovement);
+	CSV_SCOPED_TIMING_STAT(DoodleJump, Movement);
+
+	if (DeltaTime < MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	UpdateStateTimer(DeltaTime);
+
+	FHitResult Hit(1.0f);
+
+	// Frozen onto an actor - follow it and nothing else. Moving platforms already carried us in their update.
+	if (IsFrozen() && FreezeAttachmentActor)
+	{
+		Velocity = FVector::ZeroVector;
+		if (bFreezeCarried)
+		{
+			return;
+		}
+		const FVector TargetLocation = FreezeAttachmentActor->GetActorLocation() + FreezeRelativeOffset;
+		SafeMoveUpdatedComponent(TargetLocation - UpdatedComponent->GetComponentLocation(), UpdatedComponent->GetComponentQuat(), true, Hit);
+		return;
+	}
+
+	// Horizontal velocity: pure direct input, no inertia. Knockback keeps its launch velocity instead.
+	switch (DoodleState)
+	{
+	case EDoodleMovementState::Normal:
+		{
+			const FVector InputDirection = Acceleration.GetSafeNormal2D();
+			Velocity.X = InputDirection.X * MaxWalkSpeed;
+			Velocity.Y = InputDirection.Y * MaxWalkSpeed;
+			// Only a step driven by this tick's consumed input applies the Move event; idle steps and later substeps don't
+			if (bConsumedMoveInput && !InputDirection.IsZero())
+			{
+				FDoodleInputLatencyProbe::MarkMotion();
+				bConsumedMoveInput = false;
+			}
+		}
+		break;
+	case EDoodleMovementState::Frozen:
+		Velocity.X = 0.0f;
+		Velocity.Y = 0.0f;
+		break;
+	case EDoodleMovementState::KnockedBack:
+		break;
+	}
+
+	Velocity.Z += GetGravityZ() * DeltaTime;
+
+	const FVector Delta = Velocity * DeltaTime;
+	SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
+
+	if (!Hit.IsValidBlockingHit())
+	{
+		return;
+	}
+
+	if (Velocity.Z <= 0.0f && IsWalkable(Hit))
+	{
+		HandleLanding(Hit);
+		return;
+	}
+
+	// Bumped a ceiling - stop rising
+	if (Hit.ImpactNormal.Z < -0.7f && Velocity.Z > 0.0f)
+	{
+		Velocity.Z = 0.0f;
+	}
+
+	// Wall contact is the only case that needs a second sweep
+	HandleImpact(Hit, DeltaTime, Delta);
+	SlideAlongSurface(Delta, 1.0f - Hit.Time, Hit.Normal, Hit, true);
+}
+
+void UDoodleMovementComponent::UpdateStateTimer(float DeltaTime)
+{
+	if (DoodleState == EDoodleMovementState::Normal)
+	{
+		return;
+	}
+
+	StateTimeRemaining -= DeltaTime;
+	if (StateTimeRemaining > 0.0f)
+	{
+		return;
+	}
+
+	StateTimeRemaining = 0.0f;
+
+	if (DoodleState == EDoodleMovementState::Frozen)
+	{
+		EndFreeze(true);
+	}
+	else
+	{
+		DoodleState = EDoodleMovementState::Normal;
+		DOODLE_TRACE(KnockbackEnd, CharacterOwner);
+	}
+}
+
+void UDoodleMovementComponent::HandleLanding(const FHitResult& Hit)
+{
+	if (IsFrozen())
+	{
+		// Frozen characters rest where they land
+		Velocity.Z = 0.0f;
+		return;
+	}
+
+	if (CharacterOwner)
+	{
+		CharacterOwner->Landed(Hit);
+	}
+
+	// Auto-bounce straight off the landing event - no per-frame polling
+	Bounce();
+
+	if (CharacterOwner)
+	{
+		CharacterOwner->OnJumped();
+	}
+}
+
+void UDoodleMovementComponent::Bounce(float Multiplier)
+{
+	Velocity.Z = JumpZVelocity * Multiplier;
+}
+
+void UDoodleMovementComponent::Freeze(float Duration, AActor* AttachToActor)
+{
+	DoodleState = EDoodleMovementState::Frozen;
+	StateTimeRemaining = Duration;
+	FreezeAttachmentActor = AttachToActor;
+	Velocity = FVector::ZeroVector;
+
+	// Store relative offset from attachment actor so the character follows it
+	if (AttachToActor && UpdatedComponent)
+	{
+		FreezeRelativeOffset = UpdatedComponent->GetComponentLocation() - AttachToActor->GetActorLocation();
+	}
+	StartFreezeCarry();
+
+	DOODLE_TRACE(Freeze, CharacterOwner, AttachToActor, Duration, FreezeRelativeOffset.X, FreezeRelativeOffset.Y, FreezeRelativeOffset.Z);
+}
+
+void UDoodleMovementComponent::EndFreeze(bool bLaunch)
+{
+	DOODLE_TRACE(Unfreeze, CharacterOwner, FreezeAttachmentActor, bLaunch ? 1.0f : 0.0f);
+
+	DoodleState = EDoodleMovementState::Normal;
+	StateTimeRemaining = 0.0f;
+
+	StopFreezeCarry();
+	FreezeAttachmentActor = nullptr;
+
+	// Immediately launch character upward (auto-jump after unfreeze)
+	if (bLaunch)
+	{
+		Bounce();
+	}
+}
+
+void UDoodleMovementComponent::StartFreezeCarry()
+{
+	StopFreezeCarry();
+
+	UMovingPlatformSubsystem* MovingPlatforms = GetWorld()->GetSubsystem<UMovingPlatformSubsystem>();
+	bFreezeCarried = MovingPlatforms && UpdatedComponent && FreezeAttachmentActor
+		&& MovingPlatforms->AddRider(UpdatedComponent, FreezeAttachmentActor, FreezeRelativeOffset);
+}
+
+void UDoodleMovementComponent::StopFreezeCarry()
+{
+	if (!bFreezeCarried)
+	{
+		return;
+	}
+
+	bFreezeCarried = false;
+	if (UMovingPlatformSubsystem* MovingPlatforms = GetWorld()->GetSubsystem<UMovingPlatformSubsystem>())
+	{
+		MovingPlatforms->RemoveRider(UpdatedComponent);
+	}
+}
+
+void UDoodleMovementComponent::ResetDoodleState()
+{
+	StopFreezeCarry();
+
+	DoodleState = EDoodleMovementState::Normal;
+	StateTimeRemaining = 0.0f;
+	FreezeAttachmentActor = nullptr;
+	FreezeRelativeOffset = FVector::ZeroVector;
+	LatchedMoveInput = FVector2D::ZeroVector;
+	bHasLatchedMoveInput = false;
+	bConsumedMoveInput = false;
+
+	Velocity = FVector::ZeroVector;
+	PendingLaunchVelocity = FVector::ZeroVector;
+	ClearAccumulatedForces();
+	SetMovementMode(MOVE_Custom, CMOVE_Doodle);
+}
+
+void UDoodleMovementComponent::Knockback(const FVector& Direction, float Force)
+{
+	// If character is frozen, unfreeze them first (without the unfreeze bounce)
+	if (IsFrozen())
+	{
+		EndFreeze(false);
+	}
+
+	DoodleState = EDoodleMovementState::KnockedBack;
+	StateTimeRemaining = KnockbackDuration;
+
+	// Normalize direction to ensure consistent knockback force
+	const FVector KnockbackDirection = Direction.GetSafeNormal();
+	Velocity = KnockbackDirection * Force;
+
+	DOODLE_TRACE(Knockback, CharacterOwner, nullptr, KnockbackDirection.X, KnockbackDirection.Y, KnockbackDirection.Z, Force);
+}
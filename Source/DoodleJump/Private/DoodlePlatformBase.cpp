@@ -0,0 +1,77 @@
+#include "DoodlePlatformBase.h"
+#include "DoodleContactSubsystem.h"
+#include "DoodlePlatformTuning.h"
+#include "DoodleWorldResetSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+
+ADoodlePlatformBase::ADoodlePlatformBase()
+{
+	// Driven by contacts only
+	PrimaryActorTick.bCanEverTick = false;
+
+	Tuning = nullptr;
+	HeightIndexHandle = INDEX_NONE;
+}
+
+void ADoodlePlatformBase::BeginPlay()
+{
+	if (Tuning)
+	{
+		ApplyTuning(*Tuning);
+	}
+
+	Super::BeginPlay();
+
+	if (!GetOwner())
+	{
+		if (UDoodleWorldResetSubsystem* Reset = GetWorld()->GetSubsystem<UDoodleWorldResetSubsystem>())
+		{
+			Reset->RegisterResettable(this, FSimpleDelegate::CreateUObject(this, &ADoodlePlatformBase::ResetPlatform));
+		}
+
+		if (UDoodleHeightIndexSubsystem* HeightIndex = GetWorld()->GetSubsystem<UDoodleHeightIndexSubsystem>())
+		{
+			HeightIndexHandle = HeightIndex->AddActor(this, GetHeightCategory(), false);
+		}
+	}
+}
+
+void ADoodlePlatformBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UDoodleContactSubsystem* Contacts = GetWorld()->GetSubsystem<UDoodleContactSubsystem>())
+	{
+		for (const TWeakObjectPtr<UPrimitiveComponent>& Component : ContactComponents)
+		{
+			Contacts->UnregisterHazard(Component.Get());
+		}
+	}
+	ContactComponents.Empty();
+
+	if (UDoodleWorldResetSubsystem* Reset = GetWorld()->GetSubsystem<UDoodleWorldResetSubsystem>())
+	{
+		Reset->UnregisterResettable(this);
+	}
+
+	if (UDoodleHeightIndexSubsystem* HeightIndex = GetWorld()->GetSubsystem<UDoodleHeightIndexSubsystem>())
+	{
+		HeightIndex->Remove(HeightIndexHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ADoodlePlatformBase::ResetPlatform()
+{
+}
+
+void ADoodlePlatformBase::RegisterContactComponent(UPrimitiveComponent* Component)
+{
+	UDoodleContactSubsystem* Contacts = GetWorld()->GetSubsystem<UDoodleContactSubsystem>();
+	if (!Component || !Contacts)
+	{
+		return;
+	}
+
+	Contacts->RegisterHazard(Component, FDoodleContactDelegate::CreateUObject(this, &ADoodlePlatformBase::HandleContact));
+	ContactComponents.AddUnique(Component);
+}
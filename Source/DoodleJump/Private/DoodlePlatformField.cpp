@@ -0,0 +1,233 @@
+#include "DoodlePlatformField.h"
+#include "DoodleCharacter.h"
+#include "DoodleHeightIndexSubsystem.h"
+#include "DoodleJump.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+ADoodlePlatformField::ADoodlePlatformField()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
+	RootComponent->SetMobility(EComponentMobility::Static);
+}
+
+void ADoodlePlatformField::BeginPlay()
+{
+	Super::BeginPlay();
+
+	for (UHierarchicalInstancedStaticMeshComponent* Component : TypeComponents)
+	{
+		if (Component)
+		{
+			Component->OnComponentHit.AddDynamic(this, &ADoodlePlatformField::OnInstanceHit);
+		}
+	}
+
+	for (int32 TypeIndex = 0; TypeIndex < TypeComponents.Num(); ++TypeIndex)
+	{
+		const int32 NumInstances = TypeComponents[TypeIndex] ? TypeComponents[TypeIndex]->GetInstanceCount() : 0;
+		for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; ++InstanceIndex)
+		{
+			AddToHeightIndex(TypeIndex, InstanceIndex);
+		}
+	}
+
+	UE_LOG(LogDoodleJump, Log, TEXT("PlatformField '%s': %d platforms in %d instanced components"), *GetName(), GetNumPlatforms(), TypeComponents.Num());
+}
+
+void ADoodlePlatformField::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UDoodleHeightIndexSubsystem* HeightIndex = GetWorld()->GetSubsystem<UDoodleHeightIndexSubsystem>())
+	{
+		for (int32& Handle : HeightIndexHandles)
+		{
+			HeightIndex->Remove(Handle);
+		}
+	}
+	HeightIndexHandles.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+UHierarchicalInstancedStaticMeshComponent* ADoodlePlatformField::GetOrCreateTypeComponent(int32 TypeIndex)
+{
+	if (!PlatformTypes.IsValidIndex(TypeIndex) || !PlatformTypes[TypeIndex].Mesh)
+	{
+		return nullptr;
+	}
+
+	if (TypeComponents.Num() < PlatformTypes.Num())
+	{
+		TypeComponents.SetNum(PlatformTypes.Num());
+	}
+
+	UHierarchicalInstancedStaticMeshComponent*& Component = TypeComponents[TypeIndex];
+	if (!Component)
+	{
+		const FDoodlePlatformFieldType& Type = PlatformTypes[TypeIndex];
+
+		// Created as an instance component so the editor conversion saves with the level and can be undone
+		Modify();
+		Component = NewObject<UHierarchicalInstancedStaticMeshComponent>(this, *FString::Printf(TEXT("Platforms_%d"), TypeIndex), RF_Transactional);
+		Component->CreationMethod = EComponentCreationMethod::Instance;
+		Component->SetMobility(RootComponent->Mobility);
+		Component->SetupAttachment(RootComponent);
+		Component->SetStaticMesh(Type.Mesh);
+		Component->SetCollisionProfileName(TEXT("BlockAll"));
+		Component->SetNotifyRigidBodyCollision(Type.Kind != EDoodlePlatformKind::Plain);
+		AddInstanceComponent(Component);
+		Component->RegisterComponent();
+
+		if (HasActorBegunPlay())
+		{
+			Component->OnComponentHit.AddDynamic(this, &ADoodlePlatformField::OnInstanceHit);
+		}
+	}
+
+	return Component;
+}
+
+int32 ADoodlePlatformField::AddPlatform(int32 TypeIndex, const FTransform& WorldTransform)
+{
+	UHierarchicalInstancedStaticMeshComponent* Component = GetOrCreateTypeComponent(TypeIndex);
+	if (Component && !HasActorBegunPlay())
+	{
+		// Editor edits are recorded by the surrounding transaction
+		Component->Modify();
+	}
+	const int32 InstanceIndex = Component ? Component->AddInstance(WorldTransform, true) : INDEX_NONE;
+
+	if (InstanceIndex != INDEX_NONE && HasActorBegunPlay())
+	{
+		AddToHeightIndex(TypeIndex, InstanceIndex);
+	}
+	return InstanceIndex;
+}
+
+void ADoodlePlatformField::AddToHeightIndex(int32 TypeIndex, int32 InstanceIndex)
+{
+	UDoodleHeightIndexSubsystem* HeightIndex = GetWorld()->GetSubsystem<UDoodleHeightIndexSubsystem>();
+	const UHierarchicalInstancedStaticMeshComponent* Component = TypeComponents[TypeIndex];
+	FTransform InstanceTransform;
+	if (!HeightIndex || !Component->GetInstanceTransform(InstanceIndex, InstanceTransform, true))
+	{
+		return;
+	}
+
+	const FBox Bounds = Component->GetStaticMesh()->GetBounds().GetBox().TransformBy(InstanceTransform);
+	const EDoodleHeightCategory Category = PlatformTypes[TypeIndex].Kind == EDoodlePlatformKind::Trap ? DHC_Trap : DHC_Platform;
+	HeightIndexHandles.Add(HeightIndex->AddBounds(this, MakeHeightIndexItem(TypeIndex, InstanceIndex), Bounds, Category));
+}
+
+int32 ADoodlePlatformField::GetNumPlatforms() const
+{
+	int32 NumPlatforms = 0;
+	for (const UHierarchicalInstancedStaticMeshComponent* Component : TypeComponents)
+	{
+		NumPlatforms += Component ? Component->GetInstanceCount() : 0;
+	}
+	return NumPlatforms;
+}
+
+int32 ADoodlePlatformField::GetPlatformType(const UPrimitiveComponent* Component) const
+{
+	return Component ? TypeComponents.IndexOfByKey(Component) : INDEX_NONE;
+}
+
+void ADoodlePlatformField::OnInstanceHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+{
+	INC_DWORD_STAT(STAT_DoodleHitEvents);
+
+	const int32 TypeIndex = GetPlatformType(HitComponent);
+	ADoodleCharacter* Character = Cast<ADoodleCharacter>(OtherActor);
+	if (TypeIndex == INDEX_NONE || !Character)
+	{
+		return;
+	}
+
+	// Only landings on top count, same rule as ABreakablePlatform
+	if (FMath::Abs(Hit.Normal.Z) <= 0.7f || Character->GetActorLocation().Z < Hit.ImpactPoint.Z)
+	{
+		return;
+	}
+
+	const FDoodlePlatformFieldType& Type = PlatformTypes[TypeIndex];
+	switch (Type.Kind)
+	{
+	case EDoodlePlatformKind::Launchpad:
+		Character->ActivateJumpBoost(Type.BoostMultiplier);
+		break;
+	case EDoodlePlatformKind::Trap:
+		Character->FreezeCharacter(Type.FreezeDuration);
+		break;
+	case EDoodlePlatformKind::Plain:
+		break;
+	}
+}
+
+#if WITH_EDITOR
+void ADoodlePlatformField::ConvertPlacedPlatforms()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	auto CountActorsAndComponents = [World](int32& OutActors, int32& OutComponents)
+	{
+		OutActors = 0;
+		OutComponents = 0;
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			OutActors++;
+			OutComponents += It->GetComponents().Num();
+		}
+	};
+
+	int32 ActorsBefore, ComponentsBefore;
+	CountActorsAndComponents(ActorsBefore, ComponentsBefore);
+
+	Modify();
+
+	// Only plain static mesh actors - Blueprint platforms carry their own logic and stay actors
+	TArray<AStaticMeshActor*> Converted;
+	for (TActorIterator<AStaticMeshActor> It(World); It; ++It)
+	{
+		AStaticMeshActor* MeshActor = *It;
+		if (MeshActor->GetClass() != AStaticMeshActor::StaticClass() || !MeshActor->GetStaticMeshComponent())
+		{
+			continue;
+		}
+
+		const UStaticMesh* Mesh = MeshActor->GetStaticMeshComponent()->GetStaticMesh();
+		const int32 TypeIndex = PlatformTypes.IndexOfByPredicate([Mesh](const FDoodlePlatformFieldType& Type) { return Mesh && Type.Mesh == Mesh; });
+		if (TypeIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		if (AddPlatform(TypeIndex, MeshActor->GetActorTransform()) != INDEX_NONE)
+		{
+			Converted.Add(MeshActor);
+		}
+	}
+
+	for (AStaticMeshActor* MeshActor : Converted)
+	{
+		MeshActor->Modify();
+		World->EditorDestroyActor(MeshActor, true);
+	}
+
+	int32 ActorsAfter, ComponentsAfter;
+	CountActorsAndComponents(ActorsAfter, ComponentsAfter);
+
+	UE_LOG(LogDoodleJump, Log, TEXT("PlatformField '%s': converted %d platforms. Actors %d -> %d, components %d -> %d"),
+		*GetName(), Converted.Num(), ActorsBefore, ActorsAfter, ComponentsBefore, ComponentsAfter);
+}
+#endif
@@ -0,0 +1,71 @@
+#include "DoodlePlatformMeshSwap.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimSequenceBase.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<bool> CVarLazyPlatformMeshes(
+	TEXT("doodle.LazyPlatformMeshes"),
+	true,
+	TEXT("Render idle animated platforms as static meshes and wake the skeletal mesh only while animating. Read at BeginPlay."));
+
+bool FDoodlePlatformMeshSwap::CanUse(const UStaticMeshComponent* IdleMesh)
+{
+	return CVarLazyPlatformMeshes.GetValueOnGameThread() && IdleMesh && IdleMesh->GetStaticMesh();
+}
+
+void FDoodlePlatformMeshSwap::SetIdle(USkeletalMeshComponent* SkeletalMesh, UStaticMeshComponent* IdleMesh, ECollisionEnabled::Type CollisionEnabled)
+{
+	SkeletalMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SkeletalMesh->SetComponentTickEnabled(false);
+	SkeletalMesh->bNoSkeletonUpdate = true;
+	SkeletalMesh->SetVisibility(false);
+
+	IdleMesh->SetVisibility(true);
+	IdleMesh->SetCollisionEnabled(CollisionEnabled);
+}
+
+void FDoodlePlatformMeshSwap::SetAnimated(USkeletalMeshComponent* SkeletalMesh, UStaticMeshComponent* IdleMesh, ECollisionEnabled::Type CollisionEnabled)
+{
+	IdleMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	IdleMesh->SetVisibility(false);
+
+	SkeletalMesh->bNoSkeletonUpdate = false;
+	SkeletalMesh->SetComponentTickEnabled(true);
+	SkeletalMesh->SetVisibility(true);
+	SkeletalMesh->SetCollisionEnabled(CollisionEnabled);
+}
+
+float FDoodlePlatformMeshSwap::PlayAnimation(USkeletalMeshComponent* SkeletalMesh, UAnimSequenceBase* Animation)
+{
+	if (!Animation)
+	{
+		return 0.0f;
+	}
+
+	if (UAnimInstance* AnimInstance = SkeletalMesh->GetAnimInstance())
+	{
+		AnimInstance->Montage_Play(Cast<UAnimMontage>(Animation), 1.0f);
+	}
+	else
+	{
+		SkeletalMesh->PlayAnimation(Animation, false);
+	}
+
+	return Animation->GetPlayLength();
+}
+
+void FDoodlePlatformMeshSwap::StopAnimation(USkeletalMeshComponent* SkeletalMesh)
+{
+	if (UAnimInstance* AnimInstance = SkeletalMesh->GetAnimInstance())
+	{
+		AnimInstance->Montage_Stop(0.0f);
+	}
+	if (SkeletalMesh->GetAnimationMode() == EAnimationMode::AnimationSingleNode)
+	{
+		SkeletalMesh->SetPosition(0.0f, false);
+		SkeletalMesh->Stop();
+	}
+}
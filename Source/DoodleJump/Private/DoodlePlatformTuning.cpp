@@ -0,0 +1,10 @@
+#include "DoodlePlatformTuning.h"
+
+UDoodlePlatformTuning::UDoodlePlatformTuning()
+{
+	BreakDelay = 0.1f;
+	bUseBreakPhysics = false;
+	BoostMultiplier = 1.5f;
+	FreezeDuration = 5.0f;
+	bAttachFrozenCharacter = true;
+}
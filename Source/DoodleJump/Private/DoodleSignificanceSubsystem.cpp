@@ -0,0 +1,207 @@
+#include "DoodleSignificanceSubsystem.h"
+#include "DoodleJump.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+
+UDoodleSignificanceSubsystem::UDoodleSignificanceSubsystem()
+{
+	Buckets.Add({ 1500.0f, 0.0f });
+	Buckets.Add({ 3000.0f, 0.1f });
+	DistantTickInterval = 0.5f;
+	CullDistanceBelow = 2500.0f;
+
+	ViewerHeight = 0.0;
+	bHasViewer = false;
+	CullFloor = -UE_BIG_NUMBER;
+}
+
+bool UDoodleSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDoodleSignificanceSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	EntryIndices.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UDoodleSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDoodleSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UDoodleSignificanceSubsystem::RegisterActor(AActor* Actor, FSimpleDelegate OnCulled)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	if (const int32* ExistingIndex = EntryIndices.Find(Actor))
+	{
+		Entries[*ExistingIndex].OnCulled = MoveTemp(OnCulled);
+		return;
+	}
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Actor = Actor;
+	Entry.Key = Actor;
+	Entry.OnCulled = MoveTemp(OnCulled);
+	Entry.BaseTickInterval = Actor->GetActorTickInterval();
+	Entry.TickInterval = Entry.BaseTickInterval;
+
+	EntryIndices.Add(Actor, Entries.Num() - 1);
+}
+
+void UDoodleSignificanceSubsystem::UnregisterActor(AActor* Actor)
+{
+	const int32* Index = EntryIndices.Find(Actor);
+	if (!Index)
+	{
+		return;
+	}
+
+	// Hand the actor back with its own tick settings
+	const FEntry& Entry = Entries[*Index];
+	Actor->SetActorTickInterval(Entry.BaseTickInterval);
+	if (Entry.Significance == EDoodleSignificance::Culled && !Entry.OnCulled.IsBound())
+	{
+		Actor->SetActorTickEnabled(true);
+	}
+
+	RemoveEntryAt(*Index);
+}
+
+void UDoodleSignificanceSubsystem::RemoveEntryAt(int32 Index)
+{
+	EntryIndices.Remove(Entries[Index].Key);
+	Entries.RemoveAtSwap(Index, EAllowShrinking::No);
+
+	if (Entries.IsValidIndex(Index))
+	{
+		EntryIndices.Add(Entries[Index].Key, Index);
+	}
+}
+
+EDoodleSignificance UDoodleSignificanceSubsystem::ClassifyHeight(double Z, float& OutTickInterval) const
+{
+	OutTickInterval = 0.0f;
+	if (Z < CullFloor)
+	{
+		return EDoodleSignificance::Culled;
+	}
+
+	if (!bHasViewer)
+	{
+		return EDoodleSignificance::Full;
+	}
+
+	const double Offset = Z - ViewerHeight;
+	if (Offset < -CullDistanceBelow)
+	{
+		return EDoodleSignificance::Culled;
+	}
+
+	const double Distance = FMath::Abs(Offset);
+	OutTickInterval = DistantTickInterval;
+	for (const FDoodleSignificanceBucket& Bucket : Buckets)
+	{
+		if (Distance <= Bucket.MaxVerticalDistance)
+		{
+			OutTickInterval = Bucket.TickInterval;
+			break;
+		}
+	}
+
+	return OutTickInterval > 0.0f ? EDoodleSignificance::Reduced : EDoodleSignificance::Full;
+}
+
+void UDoodleSignificanceSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_DoodleSignificance);
+
+	Super::Tick(DeltaTime);
+
+	const APawn* Viewer = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	bHasViewer = Viewer != nullptr;
+	if (!bHasViewer)
+	{
+		return;
+	}
+	ViewerHeight = Viewer->GetActorLocation().Z;
+
+	int32 NumFull = 0;
+	int32 NumReduced = 0;
+	int32 NumCulled = 0;
+	float TicksSkipped = 0.0f;
+
+	// Backwards, so entries removed by an OnCulled delegate only swap in already visited ones
+	for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+	{
+		FEntry& Entry = Entries[Index];
+		AActor* Actor = Entry.Actor.Get();
+		if (!Actor)
+		{
+			RemoveEntryAt(Index);
+			continue;
+		}
+
+		float BucketInterval;
+		const EDoodleSignificance Significance = ClassifyHeight(Actor->GetActorLocation().Z, BucketInterval);
+
+		if (Significance == EDoodleSignificance::Culled)
+		{
+			NumCulled++;
+			TicksSkipped += 1.0f;
+
+			if (Entry.Significance != EDoodleSignificance::Culled)
+			{
+				Entry.Significance = EDoodleSignificance::Culled;
+				if (Entry.OnCulled.IsBound())
+				{
+					// The delegate may unregister the actor, so run a copy and do not touch Entry afterwards
+					FSimpleDelegate OnCulled = Entry.OnCulled;
+					OnCulled.Execute();
+				}
+				else
+				{
+					Actor->SetActorTickEnabled(false);
+				}
+			}
+			continue;
+		}
+
+		if (Entry.Significance == EDoodleSignificance::Culled && !Entry.OnCulled.IsBound())
+		{
+			Actor->SetActorTickEnabled(true);
+		}
+		Entry.Significance = Significance;
+
+		const float TickInterval = FMath::Max(Entry.BaseTickInterval, BucketInterval);
+		if (TickInterval != Entry.TickInterval)
+		{
+			Entry.TickInterval = TickInterval;
+			Actor->SetActorTickInterval(TickInterval);
+		}
+
+		if (Significance == EDoodleSignificance::Reduced)
+		{
+			NumReduced++;
+			TicksSkipped += FMath::Max(0.0f, 1.0f - DeltaTime / TickInterval);
+		}
+		else
+		{
+			NumFull++;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_DoodleSignificanceFull, NumFull);
+	SET_DWORD_STAT(STAT_DoodleSignificanceReduced, NumReduced);
+	SET_DWORD_STAT(STAT_DoodleSignificanceCulled, NumCulled);
+	INC_FLOAT_STAT_BY(STAT_DoodleTicksSkipped, TicksSkipped);
+	CSV_CUSTOM_STAT(DoodleJump, TicksSkipped, TicksSkipped, ECsvCustomStatOp::Accumulate);
+}
@@ -0,0 +1,415 @@
+#include "DoodleSimulationSubsystem.h"
+#include "DoodleCharacter.h"
+#include "DoodleJump.h"
+#include "EnhancedInputSubsystems.h"
+#include "InputActionValue.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace DoodleSimulation
+{
+	static constexpr uint32 FileMagic = 0x504E4944; // "DINP"
+	static constexpr uint16 FileVersion = 1;
+
+	// Move axes are -1..1, Look is a mouse delta in 1/64 units
+	static constexpr float MoveScale = 127.0f;
+	static constexpr float LookScale = 64.0f;
+
+	static int8 QuantizeMove(double Value)
+	{
+		return static_cast<int8>(FMath::Clamp(FMath::RoundToInt(Value * MoveScale), -127, 127));
+	}
+
+	static int16 QuantizeLook(double Value)
+	{
+		return static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Value * LookScale), -32767, 32767));
+	}
+
+	static FVector2D MoveValue(const FDoodleInputSample& Sample)
+	{
+		return FVector2D(Sample.MoveX / MoveScale, Sample.MoveY / MoveScale);
+	}
+
+	static FVector2D LookValue(const FDoodleInputSample& Sample)
+	{
+		return FVector2D(Sample.LookX / LookScale, Sample.LookY / LookScale);
+	}
+
+	static void WriteVarInt(TArray<uint8>& Out, uint32 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Out.Add(static_cast<uint8>(Value) | 0x80);
+			Value >>= 7;
+		}
+		Out.Add(static_cast<uint8>(Value));
+	}
+
+	static bool ReadVarInt(const TArray<uint8>& In, int32& Offset, uint32& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Shift = 0; Shift < 32; Shift += 7)
+		{
+			if (!In.IsValidIndex(Offset))
+			{
+				return false;
+			}
+
+			const uint8 Byte = In[Offset++];
+			OutValue |= static_cast<uint32>(Byte & 0x7F) << Shift;
+			if (!(Byte & 0x80))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Flags, then only the axes that were triggered
+	static void WriteSample(TArray<uint8>& Out, const FDoodleInputSample& Sample)
+	{
+		Out.Add(Sample.Flags);
+		if (Sample.Flags & FDoodleInputSample::HasMove)
+		{
+			Out.Add(static_cast<uint8>(Sample.MoveX));
+			Out.Add(static_cast<uint8>(Sample.MoveY));
+		}
+		if (Sample.Flags & FDoodleInputSample::HasLook)
+		{
+			Out.Add(static_cast<uint8>(Sample.LookX & 0xFF));
+			Out.Add(static_cast<uint8>(Sample.LookX >> 8));
+			Out.Add(static_cast<uint8>(Sample.LookY & 0xFF));
+			Out.Add(static_cast<uint8>(Sample.LookY >> 8));
+		}
+	}
+
+	static bool ReadSample(const TArray<uint8>& In, int32& Offset, FDoodleInputSample& OutSample)
+	{
+		if (!In.IsValidIndex(Offset))
+		{
+			return false;
+		}
+
+		OutSample = FDoodleInputSample();
+		OutSample.Flags = In[Offset++];
+
+		const int32 NumBytes = ((OutSample.Flags & FDoodleInputSample::HasMove) ? 2 : 0) + ((OutSample.Flags & FDoodleInputSample::HasLook) ? 4 : 0);
+		if (Offset + NumBytes > In.Num())
+		{
+			return false;
+		}
+
+		if (OutSample.Flags & FDoodleInputSample::HasMove)
+		{
+			OutSample.MoveX = static_cast<int8>(In[Offset++]);
+			OutSample.MoveY = static_cast<int8>(In[Offset++]);
+		}
+		if (OutSample.Flags & FDoodleInputSample::HasLook)
+		{
+			OutSample.LookX = static_cast<int16>(In[Offset] | (In[Offset + 1] << 8));
+			OutSample.LookY = static_cast<int16>(In[Offset + 2] | (In[Offset + 3] << 8));
+			Offset += 4;
+		}
+		return true;
+	}
+}
+
+UDoodleSimulationSubsystem::UDoodleSimulationSubsystem()
+{
+	FixedStepHz = 60;
+	bAlwaysFixedStep = false;
+
+	bFixedStep = false;
+	bRecording = false;
+	bReplaying = false;
+	bPreviousUseFixedTimeStep = false;
+	PreviousFixedDeltaTime = 0.0;
+	NumTicks = 0;
+	RunLength = 0;
+	ReadOffset = 0;
+	RunRemaining = 0;
+}
+
+bool UDoodleSimulationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDoodleSimulationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+
+	int32 StepHz = FixedStepHz;
+	bool bWantsFixedStep = bAlwaysFixedStep || FParse::Param(CommandLine, TEXT("DoodleFixedStep")) || FParse::Value(CommandLine, TEXT("DoodleFixedStep="), StepHz);
+
+	FString FilePath;
+	if (FParse::Value(CommandLine, TEXT("DoodleReplay="), FilePath))
+	{
+		RecordingPath = ResolvePath(FilePath);
+		bReplaying = LoadRecording(RecordingPath);
+		if (bReplaying)
+		{
+			// The recording only reproduces at the rate it was made with
+			StepHz = FixedStepHz;
+			bWantsFixedStep = true;
+		}
+	}
+	else if (FParse::Value(CommandLine, TEXT("DoodleRecord="), FilePath))
+	{
+		RecordingPath = ResolvePath(FilePath);
+		bRecording = true;
+		bWantsFixedStep = true;
+	}
+
+	if (bWantsFixedStep)
+	{
+		EnableFixedStep(StepHz);
+	}
+
+	if (bRecording || bReplaying)
+	{
+		TickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UDoodleSimulationSubsystem::HandleWorldTickStart);
+		TickEndHandle = FWorldDelegates::OnWorldTickEnd.AddUObject(this, &UDoodleSimulationSubsystem::HandleWorldTickEnd);
+	}
+}
+
+void UDoodleSimulationSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+	FWorldDelegates::OnWorldTickEnd.Remove(TickEndHandle);
+
+	if (bRecording)
+	{
+		FlushRun();
+		SaveRecording();
+		bRecording = false;
+	}
+	bReplaying = false;
+	Stream.Empty();
+
+	if (bFixedStep)
+	{
+		FApp::SetUseFixedTimeStep(bPreviousUseFixedTimeStep);
+		FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+		bFixedStep = false;
+	}
+
+	Super::Deinitialize();
+}
+
+void UDoodleSimulationSubsystem::EnableFixedStep(int32 StepHz)
+{
+	StepHz = FMath::Clamp(StepHz, 10, 1000);
+	FixedStepHz = StepHz;
+
+	bPreviousUseFixedTimeStep = FApp::UseFixedTimeStep();
+	PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+
+	// Every frame advances the world by exactly one step, however long it took to render
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(1.0 / StepHz);
+	bFixedStep = true;
+
+	UE_LOG(LogDoodleJump, Log, TEXT("Simulation: fixed step at %d Hz on '%s'%s"), StepHz, *MapName,
+		bRecording ? TEXT(", recording input") : bReplaying ? TEXT(", replaying input") : TEXT(""));
+}
+
+FString UDoodleSimulationSubsystem::ResolvePath(const FString& FilePath)
+{
+	return FPaths::IsRelative(FilePath) ? FPaths::ProjectSavedDir() / TEXT("InputRecordings") / FilePath : FilePath;
+}
+
+void UDoodleSimulationSubsystem::RecordMoveInput(FVector2D& Value)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	FrameSample.Flags |= FDoodleInputSample::HasMove;
+	FrameSample.MoveX = DoodleSimulation::QuantizeMove(Value.X);
+	FrameSample.MoveY = DoodleSimulation::QuantizeMove(Value.Y);
+
+	// Apply exactly what the replay will inject
+	Value = DoodleSimulation::MoveValue(FrameSample);
+}
+
+void UDoodleSimulationSubsystem::RecordLookInput(FVector2D& Value)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	FrameSample.Flags |= FDoodleInputSample::HasLook;
+	FrameSample.LookX = DoodleSimulation::QuantizeLook(Value.X);
+	FrameSample.LookY = DoodleSimulation::QuantizeLook(Value.Y);
+
+	Value = DoodleSimulation::LookValue(FrameSample);
+}
+
+void UDoodleSimulationSubsystem::HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld() || TickType != LEVELTICK_All || !bReplaying)
+	{
+		return;
+	}
+
+	ADoodleCharacter* Character = Cast<ADoodleCharacter>(UGameplayStatics::GetPlayerCharacter(World, 0));
+	APlayerController* PlayerController = Character ? Cast<APlayerController>(Character->GetController()) : nullptr;
+	UEnhancedInputLocalPlayerSubsystem* InputSubsystem = PlayerController ? ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()) : nullptr;
+
+	FDoodleInputSample Sample;
+	if (!ReadNextSample(Sample))
+	{
+		bReplaying = false;
+		if (InputSubsystem && Character->InputMappingContext)
+		{
+			InputSubsystem->AddMappingContext(Character->InputMappingContext, 0);
+		}
+
+		UE_LOG(LogDoodleJump, Log, TEXT("Simulation: replay of '%s' finished after %u ticks, live input restored"), *RecordingPath, NumTicks);
+		return;
+	}
+	NumTicks++;
+
+	// Injected input is processed with the player controller's tick, exactly where the live input was
+	if (!InputSubsystem)
+	{
+		return;
+	}
+
+	if ((Sample.Flags & FDoodleInputSample::HasMove) && Character->GetMoveAction())
+	{
+		InputSubsystem->InjectInputForAction(Character->GetMoveAction(), FInputActionValue(DoodleSimulation::MoveValue(Sample)));
+	}
+	if ((Sample.Flags & FDoodleInputSample::HasLook) && Character->GetLookAction())
+	{
+		InputSubsystem->InjectInputForAction(Character->GetLookAction(), FInputActionValue(DoodleSimulation::LookValue(Sample)));
+	}
+}
+
+void UDoodleSimulationSubsystem::HandleWorldTickEnd(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld() || TickType != LEVELTICK_All || !bRecording)
+	{
+		return;
+	}
+
+	if (RunLength > 0 && FrameSample == RunSample)
+	{
+		RunLength++;
+	}
+	else
+	{
+		FlushRun();
+		RunSample = FrameSample;
+		RunLength = 1;
+	}
+
+	FrameSample = FDoodleInputSample();
+	NumTicks++;
+}
+
+void UDoodleSimulationSubsystem::FlushRun()
+{
+	if (RunLength == 0)
+	{
+		return;
+	}
+
+	DoodleSimulation::WriteVarInt(Stream, RunLength);
+	DoodleSimulation::WriteSample(Stream, RunSample);
+	RunLength = 0;
+}
+
+bool UDoodleSimulationSubsystem::ReadNextSample(FDoodleInputSample& OutSample)
+{
+	if (RunRemaining == 0)
+	{
+		if (!DoodleSimulation::ReadVarInt(Stream, ReadOffset, RunRemaining) || RunRemaining == 0
+			|| !DoodleSimulation::ReadSample(Stream, ReadOffset, RunSample))
+		{
+			return false;
+		}
+	}
+
+	RunRemaining--;
+	OutSample = RunSample;
+	return true;
+}
+
+void UDoodleSimulationSubsystem::SaveRecording()
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = DoodleSimulation::FileMagic;
+	uint16 Version = DoodleSimulation::FileVersion;
+	uint16 StepHz = static_cast<uint16>(FixedStepHz);
+	FString RecordedMap = MapName;
+	Writer << Magic << Version << StepHz << NumTicks << RecordedMap;
+	Writer.Serialize(Stream.GetData(), Stream.Num());
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(RecordingPath), true);
+	if (FFileHelper::SaveArrayToFile(Bytes, *RecordingPath))
+	{
+		UE_LOG(LogDoodleJump, Log, TEXT("Simulation: recorded %u ticks of input on '%s' to '%s' (%d bytes)"), NumTicks, *MapName, *RecordingPath, Bytes.Num());
+	}
+	else
+	{
+		UE_LOG(LogDoodleJump, Error, TEXT("Simulation: could not write input recording '%s'"), *RecordingPath);
+	}
+}
+
+bool UDoodleSimulationSubsystem::LoadRecording(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		UE_LOG(LogDoodleJump, Error, TEXT("Simulation: could not read input recording '%s'"), *FilePath);
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	uint16 StepHz = 0;
+	uint32 RecordedTicks = 0;
+	FString RecordedMap;
+	Reader << Magic << Version << StepHz << RecordedTicks << RecordedMap;
+
+	if (Reader.IsError() || Magic != DoodleSimulation::FileMagic || Version != DoodleSimulation::FileVersion || StepHz == 0)
+	{
+		UE_LOG(LogDoodleJump, Error, TEXT("Simulation: '%s' is not a version %d input recording"), *FilePath, DoodleSimulation::FileVersion);
+		return false;
+	}
+
+	// Menu worlds and other maps run live; only the recorded map replays
+	if (RecordedMap != MapName)
+	{
+		UE_LOG(LogDoodleJump, Log, TEXT("Simulation: '%s' was recorded on '%s', not replaying it on '%s'"), *FilePath, *RecordedMap, *MapName);
+		return false;
+	}
+
+	const int32 HeaderSize = static_cast<int32>(Reader.Tell());
+	Stream = TArray<uint8>(Bytes.GetData() + HeaderSize, Bytes.Num() - HeaderSize);
+	ReadOffset = 0;
+	RunRemaining = 0;
+	FixedStepHz = StepHz;
+
+	UE_LOG(LogDoodleJump, Log, TEXT("Simulation: replaying %u ticks from '%s'"), RecordedTicks, *FilePath);
+	return true;
+}
@@ -0,0 +1,463 @@
+#include "DoodleTickAuditSubsystem.h"
+#include "DoodleJump.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UnrealType.h"
+
+namespace DoodleTickAudit
+{
+	// Groups the auditor can stand in for - the physics bracket groups are left to the engine
+	static const ETickingGroup SampledGroups[] = { TG_PrePhysics, TG_DuringPhysics, TG_PostPhysics, TG_PostUpdateWork };
+
+	static bool CanStandIn(ETickingGroup TickGroup)
+	{
+		for (const ETickingGroup Group : SampledGroups)
+		{
+			if (Group == TickGroup)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs TickAuditCommand(
+		TEXT("doodle.TickAudit"),
+		TEXT("Audit ticking actors and components for [Seconds] (config default without), 0 stops and writes the report."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UDoodleTickAuditSubsystem* Auditor = World ? World->GetSubsystem<UDoodleTickAuditSubsystem>() : nullptr;
+			if (!Auditor)
+			{
+				return;
+			}
+
+			const float Seconds = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 0.0f;
+			if (Args.Num() > 0 && Seconds <= 0.0f)
+			{
+				Auditor->StopAudit();
+			}
+			else
+			{
+				Auditor->StartAudit(Seconds);
+			}
+		}));
+}
+
+void FDoodleTickAuditFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Auditor)
+	{
+		Auditor->RunSamples(TickGroup, DeltaTime, TickType);
+	}
+}
+
+FString FDoodleTickAuditFunction::DiagnosticMessage()
+{
+	return TEXT("UDoodleTickAuditSubsystem samples");
+}
+
+UDoodleTickAuditSubsystem::UDoodleTickAuditSubsystem()
+{
+	DefaultDuration = 30.0f;
+	SamplesPerFrame = 32;
+	MinSamplesToFlag = 20;
+	RescanInterval = 1.0f;
+
+	bAuditing = false;
+	Duration = 0.0f;
+	StartTime = 0.0;
+	LastScanTime = 0.0;
+	NumFrames = 0;
+	NextSampleTarget = 0;
+}
+
+bool UDoodleTickAuditSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDoodleTickAuditSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UDoodleTickAuditSubsystem::HandleWorldTickStart);
+}
+
+void UDoodleTickAuditSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+
+	// A run cut short by a map change or exit still gets its report. Nothing ticks after this, so the taken
+	// ticks can go back right away.
+	StopAudit();
+	HandBackTicks();
+
+	Super::Deinitialize();
+}
+
+void UDoodleTickAuditSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	float Seconds = 0.0f;
+	if (FParse::Value(FCommandLine::Get(), TEXT("DoodleTickAudit="), Seconds) || FParse::Param(FCommandLine::Get(), TEXT("DoodleTickAudit")))
+	{
+		StartAudit(Seconds);
+	}
+}
+
+void UDoodleTickAuditSubsystem::StartAudit(float InDuration)
+{
+	if (bAuditing)
+	{
+		UE_LOG(LogDoodleJump, Warning, TEXT("Tick audit already running"));
+		return;
+	}
+
+	bAuditing = true;
+	Duration = InDuration > 0.0f ? InDuration : DefaultDuration;
+	StartTime = GetWorld()->GetRealTimeSeconds();
+	LastScanTime = StartTime;
+	NumFrames = 0;
+	NextSampleTarget = 0;
+
+	for (const ETickingGroup Group : DoodleTickAudit::SampledGroups)
+	{
+		FDoodleTickAuditFunction& Function = GroupFunctions[Group];
+		Function.Auditor = this;
+		Function.TickGroup = Group;
+		Function.EndTickGroup = Group;
+		Function.bCanEverTick = true;
+		Function.bStartWithTickEnabled = true;
+		Function.RegisterTickFunction(GetWorld()->PersistentLevel);
+	}
+
+	ScanTargets();
+
+	UE_LOG(LogDoodleJump, Log, TEXT("Tick audit: %.0f s, %d tick functions in %d classes"), Duration, Targets.Num(), Classes.Num());
+}
+
+void UDoodleTickAuditSubsystem::StopAudit()
+{
+	if (!bAuditing)
+	{
+		return;
+	}
+
+	// Some of this frame's samples may have run already - their ticks go back with TakenTicks at the next world tick
+	Samples.Reset();
+
+	for (const ETickingGroup Group : DoodleTickAudit::SampledGroups)
+	{
+		GroupFunctions[Group].UnRegisterTickFunction();
+	}
+
+	WriteReport();
+
+	bAuditing = false;
+	Classes.Empty();
+	ClassIndices.Empty();
+	Targets.Empty();
+	KnownTickFunctions.Empty();
+}
+
+void UDoodleTickAuditSubsystem::HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	// Also after the audit stopped, for the ticks taken in its last frame
+	HandBackTicks();
+
+	if (!bAuditing)
+	{
+		return;
+	}
+
+	CountTicks();
+	NumFrames++;
+
+	const double Now = World->GetRealTimeSeconds();
+	if (Now - StartTime >= Duration)
+	{
+		StopAudit();
+		return;
+	}
+
+	if (Now - LastScanTime >= RescanInterval)
+	{
+		LastScanTime = Now;
+		ScanTargets();
+	}
+
+	PickSamples();
+}
+
+void UDoodleTickAuditSubsystem::ScanTargets()
+{
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		AActor* Actor = *It;
+
+		// The player chain keeps its engine tick order
+		const bool bCanSampleActor = !Actor->IsA<APawn>() && !Actor->IsA<AController>();
+
+		if (Actor->PrimaryActorTick.bCanEverTick && Actor->PrimaryActorTick.IsTickFunctionRegistered())
+		{
+			AddTarget(Actor, Actor->PrimaryActorTick, bCanSampleActor);
+		}
+
+		Actor->ForEachComponent(false, [this, bCanSampleActor](UActorComponent* Component)
+		{
+			if (Component->PrimaryComponentTick.bCanEverTick && Component->PrimaryComponentTick.IsTickFunctionRegistered())
+			{
+				AddTarget(Component, Component->PrimaryComponentTick, bCanSampleActor);
+			}
+		});
+	}
+}
+
+void UDoodleTickAuditSubsystem::AddTarget(UObject* Object, FTickFunction& TickFunction, bool bCanSample)
+{
+	bool bAlreadyKnown = false;
+	KnownTickFunctions.Add(&TickFunction, &bAlreadyKnown);
+	if (bAlreadyKnown)
+	{
+		return;
+	}
+
+	UClass* Class = Object->GetClass();
+	int32& ClassIndex = ClassIndices.FindOrAdd(Class, INDEX_NONE);
+	if (ClassIndex == INDEX_NONE)
+	{
+		ClassIndex = Classes.AddDefaulted();
+		FClassStats& Stats = Classes[ClassIndex];
+		Stats.Class = Class;
+		Stats.bComponent = Object->IsA<UActorComponent>();
+		for (TFieldIterator<FProperty> PropertyIt(Class); PropertyIt; ++PropertyIt)
+		{
+			if (PropertyIt->HasAnyPropertyFlags(CPF_IsPlainOldData) || CastField<FObjectPropertyBase>(*PropertyIt))
+			{
+				Stats.StateProperties.Add(*PropertyIt);
+			}
+		}
+	}
+	Classes[ClassIndex].Instances++;
+
+	// Standing in for a tick is only safe when it does not have to wait for anything but its own actor
+	const AActor* OwnerActor = Cast<AActor>(Object) ? Cast<AActor>(Object) : CastChecked<UActorComponent>(Object)->GetOwner();
+	for (const FTickPrerequisite& Prerequisite : TickFunction.GetPrerequisites())
+	{
+		bCanSample &= Prerequisite.PrerequisiteObject.Get() == OwnerActor;
+	}
+
+	FTarget& Target = Targets.AddDefaulted_GetRef();
+	Target.Object = Object;
+	Target.TickFunction = &TickFunction;
+	Target.ClassIndex = ClassIndex;
+	Target.LastTickTime = TickFunction.GetLastTickGameTimeSeconds();
+	Target.bCanSample = bCanSample && DoodleTickAudit::CanStandIn(TickFunction.TickGroup);
+}
+
+void UDoodleTickAuditSubsystem::CountTicks()
+{
+	for (FTarget& Target : Targets)
+	{
+		if (!Target.Object.IsValid())
+		{
+			continue;
+		}
+
+		// Changes every time the engine runs the function, whatever its interval
+		const float LastTickTime = Target.TickFunction->GetLastTickGameTimeSeconds();
+		if (LastTickTime != Target.LastTickTime)
+		{
+			Target.LastTickTime = LastTickTime;
+			Classes[Target.ClassIndex].Ticks++;
+		}
+	}
+}
+
+void UDoodleTickAuditSubsystem::PickSamples()
+{
+	Samples.Reset();
+
+	const int32 NumTargets = Targets.Num();
+	for (int32 Visited = 0; Visited < NumTargets && Samples.Num() < SamplesPerFrame; ++Visited)
+	{
+		const int32 TargetIndex = NextSampleTarget;
+		NextSampleTarget = (NextSampleTarget + 1) % NumTargets;
+
+		// Interval ticks are left alone - standing in would reset their cooldown
+		const FTarget& Target = Targets[TargetIndex];
+		if (!Target.bCanSample || !Target.Object.IsValid() || !Target.TickFunction->IsTickFunctionEnabled() || Target.TickFunction->TickInterval > 0.0f)
+		{
+			continue;
+		}
+
+		Target.TickFunction->SetTickFunctionEnable(false);
+		Samples.Add({ TargetIndex, Target.TickFunction->TickGroup });
+		TakenTicks.Add({ Target.Object, Target.TickFunction });
+	}
+}
+
+void UDoodleTickAuditSubsystem::HandBackTicks()
+{
+	for (const FTakenTick& Taken : TakenTicks)
+	{
+		// Enabled again by someone else during the frame - already theirs
+		if (Taken.Object.IsValid() && !Taken.TickFunction->IsTickFunctionEnabled())
+		{
+			Taken.TickFunction->SetTickFunctionEnable(true);
+		}
+	}
+	TakenTicks.Reset();
+}
+
+void UDoodleTickAuditSubsystem::RunSamples(ETickingGroup TickGroup, float DeltaTime, ELevelTick TickType)
+{
+	for (const FSample& Sample : Samples)
+	{
+		if (Sample.TickGroup != TickGroup)
+		{
+			continue;
+		}
+
+		FTarget& Target = Targets[Sample.TargetIndex];
+		UObject* Object = Target.Object.Get();
+		if (!Object)
+		{
+			continue;
+		}
+
+		// Enabled again by someone else since PickSamples - the engine picks it up as newly spawned and ticks it
+		// this frame itself, so standing in would tick it twice
+		if (Target.TickFunction->IsTickFunctionEnabled())
+		{
+			continue;
+		}
+
+		// The function stays disabled for the rest of the frame and is handed back by HandBackTicks
+		FClassStats& Stats = Classes[Target.ClassIndex];
+		AActor* Actor = Cast<AActor>(Object);
+		UActorComponent* Component = Cast<UActorComponent>(Object);
+
+		// Same conditions the engine's tick functions check before ticking
+		const bool bShouldTick = Actor
+			? IsValid(Actor) && !Actor->IsActorBeingDestroyed() && Actor->HasActorBegunPlay()
+			: IsValid(Component) && Component->IsRegistered() && Component->HasBegunPlay();
+
+		if (bShouldTick)
+		{
+			FTransform TransformBefore, TransformAfter;
+			const uint32 StateBefore = SnapshotState(Object, Stats, TransformBefore);
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			if (Actor)
+			{
+				Actor->TickActor(DeltaTime * Actor->CustomTimeDilation, TickType, Actor->PrimaryActorTick);
+			}
+			else
+			{
+				const AActor* Owner = Component->GetOwner();
+				Component->TickComponent(DeltaTime * (Owner ? Owner->CustomTimeDilation : 1.0f), TickType, &Component->PrimaryComponentTick);
+			}
+			Stats.SampledCycles += FPlatformTime::Cycles64() - StartCycles;
+
+			const uint32 StateAfter = SnapshotState(Object, Stats, TransformAfter);
+			Stats.SampledTicks++;
+			Stats.Ticks++;
+			Stats.MovedSamples += TransformBefore.Equals(TransformAfter, 0.0) ? 0 : 1;
+			Stats.ChangedSamples += StateBefore != StateAfter ? 1 : 0;
+		}
+	}
+}
+
+uint32 UDoodleTickAuditSubsystem::SnapshotState(const UObject* Object, const FClassStats& Stats, FTransform& OutTransform) const
+{
+	if (const AActor* Actor = Cast<AActor>(Object))
+	{
+		OutTransform = Actor->GetActorTransform();
+	}
+	else if (const USceneComponent* SceneComponent = Cast<USceneComponent>(Object))
+	{
+		OutTransform = SceneComponent->GetComponentTransform();
+	}
+	else
+	{
+		OutTransform = FTransform::Identity;
+	}
+
+	uint32 Crc = 0;
+	for (const FProperty* Property : Stats.StateProperties)
+	{
+		Crc = FCrc::MemCrc32(Property->ContainerPtrToValuePtr<void>(Object), Property->GetSize(), Crc);
+	}
+	return Crc;
+}
+
+void UDoodleTickAuditSubsystem::WriteReport()
+{
+	struct FRow
+	{
+		const FClassStats* Stats;
+		double AverageUs;
+		double EstimatedMs;
+		bool bIdle;
+	};
+
+	TArray<FRow> Rows;
+	for (const FClassStats& Stats : Classes)
+	{
+		FRow& Row = Rows.AddDefaulted_GetRef();
+		Row.Stats = &Stats;
+		Row.AverageUs = Stats.SampledTicks > 0 ? FPlatformTime::ToMilliseconds64(Stats.SampledCycles) * 1000.0 / Stats.SampledTicks : 0.0;
+		Row.EstimatedMs = Row.AverageUs * Stats.Ticks / 1000.0;
+		Row.bIdle = Stats.SampledTicks >= MinSamplesToFlag && Stats.MovedSamples == 0 && Stats.ChangedSamples == 0;
+	}
+
+	// Most expensive first; unsampled classes by tick count after them
+	Rows.Sort([](const FRow& A, const FRow& B)
+	{
+		return A.EstimatedMs != B.EstimatedMs ? A.EstimatedMs > B.EstimatedMs : A.Stats->Ticks > B.Stats->Ticks;
+	});
+
+	const FString MapName = UGameplayStatics::GetCurrentLevelName(GetWorld());
+	const double Frames = FMath::Max<double>(NumFrames, 1.0);
+
+	FString Csv = TEXT("rank,class,kind,instances,ticks,ticks_per_frame,sampled,avg_us,est_total_ms,moved_samples,changed_samples,idle\n");
+	UE_LOG(LogDoodleJump, Log, TEXT("Tick audit of %s: %llu frames, %d classes"), *MapName, NumFrames, Rows.Num());
+
+	int32 NumIdle = 0;
+	for (int32 Rank = 0; Rank < Rows.Num(); ++Rank)
+	{
+		const FRow& Row = Rows[Rank];
+		const FClassStats& Stats = *Row.Stats;
+		const FString ClassName = Stats.Class ? Stats.Class->GetName() : TEXT("None");
+
+		Csv += FString::Printf(TEXT("%d,%s,%s,%d,%lld,%.2f,%d,%.3f,%.3f,%d,%d,%d\n"), Rank + 1, *ClassName,
+			Stats.bComponent ? TEXT("component") : TEXT("actor"), Stats.Instances, Stats.Ticks, Stats.Ticks / Frames,
+			Stats.SampledTicks, Row.AverageUs, Row.EstimatedMs, Stats.MovedSamples, Stats.ChangedSamples, Row.bIdle ? 1 : 0);
+
+		NumIdle += Row.bIdle ? 1 : 0;
+		UE_LOG(LogDoodleJump, Log, TEXT("  %3d %-40s %6d inst %8lld ticks %8.3f ms%s"), Rank + 1, *ClassName,
+			Stats.Instances, Stats.Ticks, Row.EstimatedMs, Row.bIdle ? TEXT("  IDLE") : TEXT(""));
+	}
+
+	const FString CsvPath = FPaths::ProjectSavedDir() / TEXT("TickAudit") /
+		FString::Printf(TEXT("%s-%s.csv"), *MapName, *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+	FFileHelper::SaveStringToFile(Csv, *CsvPath);
+
+	UE_LOG(LogDoodleJump, Log, TEXT("Tick audit: %d idle classes, report written to %s"), NumIdle, *CsvPath);
+}
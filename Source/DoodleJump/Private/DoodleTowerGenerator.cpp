@@ -0,0 +1,500 @@
+#include "DoodleTowerGenerator.h"
+#include "DoodleJump.h"
+#include "DoodleHeightIndexSubsystem.h"
+#include "DoodleSignificanceSubsystem.h"
+#include "MovingPlatform.h"
+#include "MovingPlatformSubsystem.h"
+#include "DoodlePlatformBase.h"
+#include "DoodleWorldResetSubsystem.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+
+ADoodleTowerGenerator::ADoodleTowerGenerator()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
+
+	ChunkHeight = 1200.0f;
+	PlatformsPerChunk = 6;
+	TowerHalfWidth = 500.0f;
+	ChunksAhead = 3;
+	ChunksBehind = 1;
+	FrameBudgetMs = 1.0f;
+	FixedStepPlacementsPerFrame = 2;
+	Seed = 1;
+
+	PendingHead = 0;
+	NextChunkToPlan = 0;
+}
+
+void ADoodleTowerGenerator::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Pools.SetNum(PlatformTypes.Num());
+
+	if (PlatformTypes.Num() == 0)
+	{
+		UE_LOG(LogDoodleJump, Warning, TEXT("TowerGenerator '%s': No platform types assigned!"), *GetName());
+	}
+
+	if (UDoodleWorldResetSubsystem* Reset = GetWorld()->GetSubsystem<UDoodleWorldResetSubsystem>())
+	{
+		Reset->RegisterResettable(this, FSimpleDelegate::CreateUObject(this, &ADoodleTowerGenerator::ResetTower));
+	}
+}
+
+void ADoodleTowerGenerator::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Generated platforms belong to the generator and go away with it
+	if (EndPlayReason == EEndPlayReason::Destroyed)
+	{
+		for (const FDoodleTowerChunk& Chunk : Chunks)
+		{
+			for (AActor* Platform : Chunk.Actors)
+			{
+				if (IsValid(Platform))
+				{
+					Platform->Destroy();
+				}
+			}
+		}
+
+		for (const FDoodleTowerPool& Pool : Pools)
+		{
+			for (AActor* Platform : Pool.FreeActors)
+			{
+				if (IsValid(Platform))
+				{
+					Platform->Destroy();
+				}
+			}
+		}
+	}
+
+	if (UDoodleWorldResetSubsystem* Reset = GetWorld()->GetSubsystem<UDoodleWorldResetSubsystem>())
+	{
+		Reset->UnregisterResettable(this);
+	}
+
+	if (UDoodleHeightIndexSubsystem* HeightIndex = GetWorld()->GetSubsystem<UDoodleHeightIndexSubsystem>())
+	{
+		for (FDoodleTowerChunk& Chunk : Chunks)
+		{
+			for (int32& Handle : Chunk.HeightIndexHandles)
+			{
+				HeightIndex->Remove(Handle);
+			}
+		}
+	}
+
+	Chunks.Empty();
+	Pools.Empty();
+	PendingPlacements.Empty();
+	PendingHead = 0;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ADoodleTowerGenerator::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_DoodleTowerGenerate);
+	CSV_SCOPED_TIMING_STAT(DoodleJump, TowerGenerate);
+
+	Super::Tick(DeltaTime);
+
+	const APawn* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	if (!Player || PlatformTypes.Num() == 0 || ChunkHeight <= 0.0f)
+	{
+		return;
+	}
+
+	const double Height = Player->GetActorLocation().Z - GetActorLocation().Z;
+	const int32 PlayerChunk = FMath::Max(0, FMath::FloorToInt32(Height / ChunkHeight));
+
+	// Recycle behind, then plan ahead. Chunks below the window are never rebuilt - falling that far ends the run.
+	int32 LowestChunk = PlayerChunk - ChunksBehind;
+
+	// Chunks entirely under the cull floor (the rising lava) are unreachable too
+	const UDoodleSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UDoodleSignificanceSubsystem>();
+	const double FloorHeight = Significance ? Significance->GetCullFloor() - GetActorLocation().Z : 0.0;
+	if (FloorHeight > 0.0)
+	{
+		LowestChunk = FMath::Max(LowestChunk, FMath::Min(PlayerChunk, FMath::FloorToInt32(FloorHeight / ChunkHeight)));
+	}
+	RecycleChunksBelow(LowestChunk);
+	NextChunkToPlan = FMath::Max(NextChunkToPlan, LowestChunk);
+	while (NextChunkToPlan <= PlayerChunk + ChunksAhead)
+	{
+		PlanChunk(NextChunkToPlan++);
+	}
+
+	ProcessPendingPlacements();
+
+	SET_DWORD_STAT(STAT_DoodleTowerChunks, Chunks.Num());
+	SET_DWORD_STAT(STAT_DoodleTowerLiveActors, GetNumLiveActors());
+	SET_DWORD_STAT(STAT_DoodleTowerPooledActors, GetNumPooledActors());
+}
+
+void ADoodleTowerGenerator::PlanChunk(int32 ChunkIndex)
+{
+	FDoodleTowerChunk& Chunk = Chunks.AddDefaulted_GetRef();
+	Chunk.Index = ChunkIndex;
+	Chunk.Actors.Reserve(PlatformsPerChunk);
+	Chunk.TypeIndices.Reserve(PlatformsPerChunk);
+	Chunk.Locations.Reserve(PlatformsPerChunk);
+	Chunk.MoveAxes.Reserve(PlatformsPerChunk);
+
+	// Seeded per chunk so the layout does not depend on when the chunk gets built
+	FRandomStream Random(HashCombine(GetTypeHash(Seed), GetTypeHash(ChunkIndex)));
+
+	const FVector Base = GetActorLocation();
+	const float RowSpacing = ChunkHeight / FMath::Max(PlatformsPerChunk, 1);
+
+	for (int32 Row = 0; Row < PlatformsPerChunk; ++Row)
+	{
+		// Rows are evenly spaced with some jitter, so every gap stays within one bounce
+		const float RowHeight = ChunkIndex * ChunkHeight + (Row + Random.FRandRange(0.25f, 0.75f)) * RowSpacing;
+		const float Angle = Random.FRandRange(0.0f, UE_TWO_PI);
+
+		FPendingPlacement& Placement = PendingPlacements.AddDefaulted_GetRef();
+		Placement.ChunkIndex = ChunkIndex;
+		Placement.TypeIndex = PickPlatformType(Random, RowHeight);
+		Placement.Location = Base + FVector(Random.FRandRange(-TowerHalfWidth, TowerHalfWidth), Random.FRandRange(-TowerHalfWidth, TowerHalfWidth), RowHeight);
+		Placement.MoveAxis = FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f);
+
+		// The very first platform sits right at the generator, under the player start
+		if (ChunkIndex == 0 && Row == 0)
+		{
+			Placement.TypeIndex = 0;
+			Placement.Location = Base;
+		}
+	}
+}
+
+int32 ADoodleTowerGenerator::PickPlatformType(FRandomStream& Random, float Height) const
+{
+	float TotalWeight = 0.0f;
+	for (const FDoodleTowerPlatformType& Type : PlatformTypes)
+	{
+		if (Height >= Type.MinHeight && (Type.PlatformClass || Type.StaticMesh))
+		{
+			TotalWeight += FMath::Max(Type.Weight, 0.0f);
+		}
+	}
+
+	// Always roll, so the rest of the chunk stays the same when weights are zero
+	float Roll = Random.FRandRange(0.0f, TotalWeight);
+	for (int32 TypeIndex = 0; TypeIndex < PlatformTypes.Num(); ++TypeIndex)
+	{
+		const FDoodleTowerPlatformType& Type = PlatformTypes[TypeIndex];
+		if (Height >= Type.MinHeight && (Type.PlatformClass || Type.StaticMesh))
+		{
+			Roll -= FMath::Max(Type.Weight, 0.0f);
+			if (Roll <= 0.0f)
+			{
+				return TypeIndex;
+			}
+		}
+	}
+
+	return 0;
+}
+
+void ADoodleTowerGenerator::ProcessPendingPlacements()
+{
+	const double Deadline = FPlatformTime::Seconds() + FrameBudgetMs * 0.001;
+	UDoodleHeightIndexSubsystem* HeightIndex = GetWorld()->GetSubsystem<UDoodleHeightIndexSubsystem>();
+
+	// A wall-clock budget would place different platforms per frame on every run - fixed-step runs place a fixed count
+	const bool bFixedStep = FApp::UseFixedTimeStep();
+	int32 NumPlaced = 0;
+
+	// At least one placement per frame so generation always makes progress
+	while (PendingHead < PendingPlacements.Num())
+	{
+		const FPendingPlacement Placement = PendingPlacements[PendingHead++];
+
+		// The chunk may have been recycled before it was built
+		const int32 Slot = Chunks.Num() > 0 ? Placement.ChunkIndex - Chunks[0].Index : INDEX_NONE;
+		if (Chunks.IsValidIndex(Slot))
+		{
+			if (AActor* Platform = AcquirePlatform(Placement))
+			{
+				Chunks[Slot].Actors.Add(Platform);
+				Chunks[Slot].TypeIndices.Add(Placement.TypeIndex);
+				Chunks[Slot].Locations.Add(Placement.Location);
+				Chunks[Slot].MoveAxes.Add(Placement.MoveAxis);
+				Chunks[Slot].HeightIndexHandles.Add(HeightIndex
+					? HeightIndex->AddActor(Platform, PlatformTypes[Placement.TypeIndex].bIsTrap ? DHC_Trap : DHC_Platform, Platform->IsA<AMovingPlatform>())
+					: INDEX_NONE);
+			}
+		}
+
+		NumPlaced++;
+		if (bFixedStep ? NumPlaced >= FMath::Max(FixedStepPlacementsPerFrame, 1) : FPlatformTime::Seconds() >= Deadline)
+		{
+			break;
+		}
+	}
+
+	if (PendingHead == PendingPlacements.Num())
+	{
+		PendingPlacements.Reset();
+		PendingHead = 0;
+	}
+}
+
+void ADoodleTowerGenerator::RecycleChunksBelow(int32 ChunkIndex)
+{
+	UDoodleHeightIndexSubsystem* HeightIndex = GetWorld()->GetSubsystem<UDoodleHeightIndexSubsystem>();
+
+	int32 NumRecycled = 0;
+	while (NumRecycled < Chunks.Num() && Chunks[NumRecycled].Index < ChunkIndex)
+	{
+		FDoodleTowerChunk& Chunk = Chunks[NumRecycled];
+		for (int32 ActorIndex = 0; ActorIndex < Chunk.Actors.Num(); ++ActorIndex)
+		{
+			if (HeightIndex)
+			{
+				HeightIndex->Remove(Chunk.HeightIndexHandles[ActorIndex]);
+			}
+			ReleasePlatform(Chunk.TypeIndices[ActorIndex], Chunk.Actors[ActorIndex]);
+		}
+		++NumRecycled;
+	}
+
+	if (NumRecycled > 0)
+	{
+		Chunks.RemoveAt(0, NumRecycled, EAllowShrinking::No);
+	}
+}
+
+AActor* ADoodleTowerGenerator::AcquirePlatform(const FPendingPlacement& Placement)
+{
+	FDoodleTowerPool& Pool = Pools[Placement.TypeIndex];
+	while (Pool.FreeActors.Num() > 0)
+	{
+		AActor* Platform = Pool.FreeActors.Pop(EAllowShrinking::No);
+		if (IsValid(Platform))
+		{
+			PlacePlatform(Platform, Placement);
+			return Platform;
+		}
+	}
+
+	const FDoodleTowerPlatformType& Type = PlatformTypes[Placement.TypeIndex];
+	UWorld* World = GetWorld();
+	const FTransform SpawnTransform(Placement.Location);
+
+	if (Type.PlatformClass)
+	{
+		// Deferred so moving platforms have their path before BeginPlay
+		AActor* Platform = World->SpawnActorDeferred<AActor>(Type.PlatformClass, SpawnTransform, this, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (Platform)
+		{
+			SetupPlatformPath(Platform, Placement);
+			Platform->FinishSpawning(SpawnTransform);
+		}
+		return Platform;
+	}
+
+	if (Type.StaticMesh)
+	{
+		// Movable, since recycled platforms are moved to their next spot
+		AStaticMeshActor* MeshActor = World->SpawnActorDeferred<AStaticMeshActor>(AStaticMeshActor::StaticClass(), SpawnTransform, this, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (MeshActor)
+		{
+			MeshActor->SetMobility(EComponentMobility::Movable);
+			MeshActor->GetStaticMeshComponent()->SetStaticMesh(Type.StaticMesh);
+			MeshActor->FinishSpawning(SpawnTransform);
+		}
+		return MeshActor;
+	}
+
+	return nullptr;
+}
+
+void ADoodleTowerGenerator::PlacePlatform(AActor* Platform, const FPendingPlacement& Placement)
+{
+	Platform->SetActorLocation(Placement.Location, false, nullptr, ETeleportType::ResetPhysics);
+	if (ADoodlePlatformBase* PlatformBase = Cast<ADoodlePlatformBase>(Platform))
+	{
+		// Resets and checkpoint restores must bring it back here, not to where it was first spawned
+		PlatformBase->SetHomeTransform(Platform->GetActorTransform());
+	}
+	Platform->SetActorHiddenInGame(false);
+	Platform->SetActorEnableCollision(true);
+	Platform->SetActorTickEnabled(Platform->PrimaryActorTick.bStartWithTickEnabled);
+	SetupPlatformPath(Platform, Placement);
+}
+
+void ADoodleTowerGenerator::SetupPlatformPath(AActor* Platform, const FPendingPlacement& Placement) const
+{
+	AMovingPlatform* MovingPlatform = Cast<AMovingPlatform>(Platform);
+	if (!MovingPlatform)
+	{
+		return;
+	}
+
+	const float MoveDistance = PlatformTypes[Placement.TypeIndex].MoveDistance;
+	if (MoveDistance > 0.0f)
+	{
+		const FVector Offset = Placement.MoveAxis * MoveDistance;
+		const FVector PathPoints[] = { Placement.Location - Offset, Placement.Location + Offset };
+		MovingPlatform->SetPathPoints(PathPoints);
+	}
+	else if (UMovingPlatformSubsystem* PlatformSubsystem = GetWorld()->GetSubsystem<UMovingPlatformSubsystem>())
+	{
+		// Types that do not move must not keep a path from an earlier placement
+		PlatformSubsystem->UnregisterPlatform(MovingPlatform);
+	}
+}
+
+void ADoodleTowerGenerator::ReleasePlatform(int32 TypeIndex, AActor* Platform)
+{
+	if (!IsValid(Platform))
+	{
+		return;
+	}
+
+	if (AMovingPlatform* MovingPlatform = Cast<AMovingPlatform>(Platform))
+	{
+		if (UMovingPlatformSubsystem* PlatformSubsystem = GetWorld()->GetSubsystem<UMovingPlatformSubsystem>())
+		{
+			PlatformSubsystem->UnregisterPlatform(MovingPlatform);
+		}
+	}
+
+	// Broken platforms may be falling or retired debris - put them back together before pooling
+	if (ADoodlePlatformBase* PlatformBase = Cast<ADoodlePlatformBase>(Platform))
+	{
+		PlatformBase->ResetPlatform();
+	}
+
+	Platform->SetActorTickEnabled(false);
+	Platform->SetActorEnableCollision(false);
+	Platform->SetActorHiddenInGame(true);
+
+	Pools[TypeIndex].FreeActors.Add(Platform);
+}
+
+void ADoodleTowerGenerator::ResetTower()
+{
+	RecycleChunksBelow(MAX_int32);
+	PendingPlacements.Reset();
+	PendingHead = 0;
+
+	if (PlatformTypes.Num() == 0)
+	{
+		NextChunkToPlan = 0;
+		return;
+	}
+
+	// The start platform has to be there on the first frame - the rest is rebuilt by Tick as usual
+	PlanChunk(0);
+	NextChunkToPlan = 1;
+	while (PendingHead < PendingPlacements.Num())
+	{
+		ProcessPendingPlacements();
+	}
+}
+
+void ADoodleTowerGenerator::RestoreChunks(TArray<FDoodleTowerChunk>& InChunks, TArray<FPendingPlacement>& InPendingPlacements, int32 InNextChunkToPlan)
+{
+	UDoodleHeightIndexSubsystem* HeightIndex = GetWorld()->GetSubsystem<UDoodleHeightIndexSubsystem>();
+
+	TSet<AActor*> KeptActors;
+	for (const FDoodleTowerChunk& Chunk : InChunks)
+	{
+		KeptActors.Append(Chunk.Actors);
+	}
+
+	// Pool whatever is out now and was not at the checkpoint, and take the checkpoint's actors back out of the pools
+	for (FDoodleTowerChunk& Chunk : Chunks)
+	{
+		for (int32 ActorIndex = 0; ActorIndex < Chunk.Actors.Num(); ++ActorIndex)
+		{
+			if (HeightIndex)
+			{
+				HeightIndex->Remove(Chunk.HeightIndexHandles[ActorIndex]);
+			}
+			if (!KeptActors.Contains(Chunk.Actors[ActorIndex]))
+			{
+				ReleasePlatform(Chunk.TypeIndices[ActorIndex], Chunk.Actors[ActorIndex]);
+			}
+		}
+	}
+
+	for (FDoodleTowerPool& Pool : Pools)
+	{
+		Pool.FreeActors.RemoveAll([&KeptActors](const AActor* Platform) { return KeptActors.Contains(Platform); });
+	}
+
+	Chunks = MoveTemp(InChunks);
+	for (FDoodleTowerChunk& Chunk : Chunks)
+	{
+		Chunk.HeightIndexHandles.Reset();
+		for (int32 ActorIndex = 0; ActorIndex < Chunk.Actors.Num(); ++ActorIndex)
+		{
+			AActor* Platform = Chunk.Actors[ActorIndex];
+			const int32 TypeIndex = Chunk.TypeIndices[ActorIndex];
+			if (!IsValid(Platform) || !PlatformTypes.IsValidIndex(TypeIndex))
+			{
+				Chunk.Actors.RemoveAt(ActorIndex);
+				Chunk.TypeIndices.RemoveAt(ActorIndex);
+				Chunk.Locations.RemoveAt(ActorIndex);
+				Chunk.MoveAxes.RemoveAt(ActorIndex);
+				--ActorIndex;
+				continue;
+			}
+
+			// Broken or falling since the checkpoint - whole again at its spot; the breakable section breaks it again if needed
+			if (ADoodlePlatformBase* PlatformBase = Cast<ADoodlePlatformBase>(Platform))
+			{
+				PlatformBase->ResetPlatform();
+			}
+
+			FPendingPlacement Placement;
+			Placement.ChunkIndex = Chunk.Index;
+			Placement.TypeIndex = TypeIndex;
+			Placement.Location = Chunk.Locations[ActorIndex];
+			Placement.MoveAxis = Chunk.MoveAxes[ActorIndex];
+			PlacePlatform(Platform, Placement);
+
+			Chunk.HeightIndexHandles.Add(HeightIndex
+				? HeightIndex->AddActor(Platform, PlatformTypes[TypeIndex].bIsTrap ? DHC_Trap : DHC_Platform, Platform->IsA<AMovingPlatform>())
+				: INDEX_NONE);
+		}
+	}
+
+	PendingPlacements = MoveTemp(InPendingPlacements);
+	PendingHead = 0;
+	NextChunkToPlan = InNextChunkToPlan;
+}
+
+int32 ADoodleTowerGenerator::GetNumLiveActors() const
+{
+	int32 NumActors = 0;
+	for (const FDoodleTowerChunk& Chunk : Chunks)
+	{
+		NumActors += Chunk.Actors.Num();
+	}
+	return NumActors;
+}
+
+int32 ADoodleTowerGenerator::GetNumPooledActors() const
+{
+	int32 NumActors = 0;
+	for (const FDoodleTowerPool& Pool : Pools)
+	{
+		NumActors += Pool.FreeActors.Num();
+	}
+	return NumActors;
+}
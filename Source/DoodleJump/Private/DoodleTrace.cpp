@@ -0,0 +1,119 @@
+#include "DoodleTrace.h"
+
+#if DOODLE_TRACE_ENABLED
+
+#include "DoodleJump.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/OutputDeviceFile.h"
+#include "Misc/Paths.h"
+
+namespace DoodleTrace
+{
+	static FDoodleTraceRecord Records[FDoodleTrace::Capacity];
+	static uint64 NumRecorded = 0;
+
+	// Built once at startup - the crash handler must not allocate
+	static FString CrashDumpPath;
+
+	static const TCHAR* EventName(EDoodleTraceEvent Event)
+	{
+		switch (Event)
+		{
+		case EDoodleTraceEvent::PlatformHit:	return TEXT("PlatformHit");
+		case EDoodleTraceEvent::PlatformBreak:	return TEXT("PlatformBreak");
+		case EDoodleTraceEvent::PlatformFall:	return TEXT("PlatformFall");
+		case EDoodleTraceEvent::DartHit:		return TEXT("DartHit");
+		case EDoodleTraceEvent::JumpBoost:		return TEXT("JumpBoost");
+		case EDoodleTraceEvent::Freeze:			return TEXT("Freeze");
+		case EDoodleTraceEvent::Unfreeze:		return TEXT("Unfreeze");
+		case EDoodleTraceEvent::Knockback:		return TEXT("Knockback");
+		case EDoodleTraceEvent::KnockbackEnd:	return TEXT("KnockbackEnd");
+		case EDoodleTraceEvent::WorldReset:		return TEXT("WorldReset");
+		case EDoodleTraceEvent::LavaKill:		return TEXT("LavaKill");
+		}
+		return TEXT("Unknown");
+	}
+
+	static const TCHAR* ObjectName(FName Name, TCHAR (&Buffer)[NAME_SIZE])
+	{
+		if (Name.IsNone())
+		{
+			return TEXT("-");
+		}
+
+		Name.ToString(Buffer);
+		return Buffer;
+	}
+
+	static FAutoConsoleCommand DumpTraceCommand(
+		TEXT("doodle.DumpTrace"),
+		TEXT("Write the gameplay event trace to Saved/Logs and the log."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FDoodleTrace::Dump(*GLog);
+			UE_LOG(LogDoodleJump, Display, TEXT("Gameplay trace written to %s"), *FDoodleTrace::DumpToFile());
+		}));
+
+	// Whatever led up to a crash is the interesting part
+	static FDelayedAutoRegisterHelper RegisterCrashDump(EDelayedRegisterRunPhase::EndOfEngineInit, []()
+	{
+		CrashDumpPath = FPaths::ProjectLogDir() / FString::Printf(TEXT("DoodleTrace-%s-Crash.txt"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+		FCoreDelegates::OnHandleSystemError.AddLambda([]()
+		{
+			FDoodleTrace::DumpToFile(*CrashDumpPath);
+		});
+	});
+}
+
+void FDoodleTrace::Record(EDoodleTraceEvent Event, const UObject* Subject, const UObject* Other, float A, float B, float C, float D)
+{
+	FDoodleTraceRecord& Record = DoodleTrace::Records[DoodleTrace::NumRecorded % Capacity];
+	Record.Time = FPlatformTime::Seconds();
+	Record.Frame = GFrameCounter;
+	Record.Subject = Subject ? Subject->GetFName() : NAME_None;
+	Record.Other = Other ? Other->GetFName() : NAME_None;
+	Record.Values[0] = A;
+	Record.Values[1] = B;
+	Record.Values[2] = C;
+	Record.Values[3] = D;
+	Record.Event = Event;
+
+	DoodleTrace::NumRecorded++;
+}
+
+void FDoodleTrace::Dump(FOutputDevice& Ar)
+{
+	const uint64 First = DoodleTrace::NumRecorded > Capacity ? DoodleTrace::NumRecorded - Capacity : 0;
+
+	TCHAR SubjectName[NAME_SIZE];
+	TCHAR OtherName[NAME_SIZE];
+
+	Ar.Logf(TEXT("Doodle gameplay trace: %llu events, showing the last %llu"), DoodleTrace::NumRecorded, DoodleTrace::NumRecorded - First);
+	for (uint64 Index = First; Index < DoodleTrace::NumRecorded; ++Index)
+	{
+		const FDoodleTraceRecord& Record = DoodleTrace::Records[Index % Capacity];
+		Ar.Logf(TEXT("%12.4f [%llu] %-14s %s -> %s (%.3f, %.3f, %.3f, %.3f)"),
+			Record.Time, Record.Frame, DoodleTrace::EventName(Record.Event),
+			DoodleTrace::ObjectName(Record.Subject, SubjectName), DoodleTrace::ObjectName(Record.Other, OtherName),
+			Record.Values[0], Record.Values[1], Record.Values[2], Record.Values[3]);
+	}
+}
+
+FString FDoodleTrace::DumpToFile()
+{
+	const FString FilePath = FPaths::ProjectLogDir() / FString::Printf(TEXT("DoodleTrace-%s.txt"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+	DumpToFile(*FilePath);
+	return FilePath;
+}
+
+void FDoodleTrace::DumpToFile(const TCHAR* FilePath)
+{
+	FOutputDeviceFile File(FilePath, true);
+	File.SetSuppressEventTag(true);
+	Dump(File);
+	File.TearDown();
+}
+
+#endif
@@ -0,0 +1,130 @@
+#include "DoodleWorldResetSubsystem.h"
+#include "DartPoolSubsystem.h"
+#include "DartProjectileSubsystem.h"
+#include "DoodleContactSubsystem.h"
+#include "DoodleJump.h"
+#include "DoodleTrace.h"
+#include "MovingPlatformSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+namespace DoodleWorldReset
+{
+	static FAutoConsoleCommandWithWorld RestartCommand(
+		TEXT("doodle.Restart"),
+		TEXT("Reset the run in place without reloading the map."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (UDoodleWorldResetSubsystem* Reset = World ? World->GetSubsystem<UDoodleWorldResetSubsystem>() : nullptr)
+			{
+				Reset->ResetWorld();
+			}
+		}));
+}
+
+UDoodleWorldResetSubsystem::UDoodleWorldResetSubsystem()
+{
+	ResetStartCycles = 0;
+	ResetFrame = 0;
+	LastResetMs = 0.0f;
+	LastRestartMs = 0.0f;
+}
+
+bool UDoodleWorldResetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDoodleWorldResetSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldTickEnd.Remove(TickEndHandle);
+	TickEndHandle.Reset();
+
+	Resettables.Empty();
+	ResettingDelegates.Empty();
+
+	Super::Deinitialize();
+}
+
+void UDoodleWorldResetSubsystem::RegisterResettable(AActor* Actor, FSimpleDelegate OnReset)
+{
+	if (Actor)
+	{
+		Resettables.Add(Actor, MoveTemp(OnReset));
+	}
+}
+
+void UDoodleWorldResetSubsystem::UnregisterResettable(AActor* Actor)
+{
+	Resettables.Remove(Actor);
+}
+
+void UDoodleWorldResetSubsystem::ResetWorld()
+{
+	SCOPE_CYCLE_COUNTER(STAT_DoodleWorldReset);
+	CSV_SCOPED_TIMING_STAT(DoodleJump, WorldReset);
+
+	ResetStartCycles = FPlatformTime::Cycles64();
+	ResetFrame = GFrameCounter;
+	UWorld* World = GetWorld();
+
+	// Darts first, so nothing in flight hits the character after it is moved back
+	if (UDartPoolSubsystem* DartPool = World->GetSubsystem<UDartPoolSubsystem>())
+	{
+		DartPool->ReleaseAllDarts();
+	}
+	if (UDartProjectileSubsystem* Projectiles = World->GetSubsystem<UDartProjectileSubsystem>())
+	{
+		Projectiles->ClearDarts();
+	}
+
+	ResettingDelegates.Reset();
+	for (const TPair<TObjectKey<AActor>, FSimpleDelegate>& Resettable : Resettables)
+	{
+		ResettingDelegates.Add(Resettable.Value);
+	}
+	const int32 NumResettables = ResettingDelegates.Num();
+	for (const FSimpleDelegate& OnReset : ResettingDelegates)
+	{
+		OnReset.ExecuteIfBound();
+	}
+	ResettingDelegates.Reset();
+
+	// After the actors, which may have recycled or re-registered platforms (tower generator)
+	if (UMovingPlatformSubsystem* MovingPlatforms = World->GetSubsystem<UMovingPlatformSubsystem>())
+	{
+		MovingPlatforms->RestartPaths();
+	}
+
+	// Hits gathered before the reset refer to where things were
+	if (UDoodleContactSubsystem* Contacts = World->GetSubsystem<UDoodleContactSubsystem>())
+	{
+		Contacts->ClearPendingContacts();
+	}
+
+	LastResetMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - ResetStartCycles);
+	DOODLE_TRACE(WorldReset, World, nullptr, LastResetMs, static_cast<float>(NumResettables));
+	CSV_EVENT(DoodleJump, TEXT("WorldReset"));
+
+	if (!TickEndHandle.IsValid())
+	{
+		TickEndHandle = FWorldDelegates::OnWorldTickEnd.AddUObject(this, &UDoodleWorldResetSubsystem::HandleWorldTickEnd);
+	}
+}
+
+void UDoodleWorldResetSubsystem::HandleWorldTickEnd(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	// Resets requested from gameplay code run mid-tick - the frame they happen in does not count
+	if (World != GetWorld() || GFrameCounter == ResetFrame)
+	{
+		return;
+	}
+
+	// The first full tick after the reset is the first playable frame
+	LastRestartMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - ResetStartCycles);
+	UE_LOG(LogDoodleJump, Log, TEXT("World reset: %.2f ms in reset, %.2f ms to the next playable frame, %d actors"),
+		LastResetMs, LastRestartMs, Resettables.Num());
+
+	FWorldDelegates::OnWorldTickEnd.Remove(TickEndHandle);
+	TickEndHandle.Reset();
+}
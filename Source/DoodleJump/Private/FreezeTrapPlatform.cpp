@@ -0,0 +1,101 @@
+#include "FreezeTrapPlatform.h"
+#include "DoodleCharacter.h"
+#include "DoodleContactSubsystem.h"
+#include "DoodleMovementComponent.h"
+#include "DoodlePlatformMeshSwap.h"
+#include "DoodlePlatformTuning.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "TimerManager.h"
+
+AFreezeTrapPlatform::AFreezeTrapPlatform()
+{
+	PlatformMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("PlatformMesh"));
+	RootComponent = PlatformMesh;
+	PlatformMesh->SetCollisionProfileName(TEXT("DoodleHazard"));
+	PlatformMesh->SetSimulatePhysics(false);
+	PlatformMesh->SetEnableGravity(false);
+
+	IdleMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("IdleMesh"));
+	IdleMesh->SetupAttachment(PlatformMesh);
+	IdleMesh->SetCollisionProfileName(TEXT("DoodleHazard"));
+	IdleMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	// Same freeze the character applies by default (ADoodleCharacter::DefaultFreezeDuration)
+	FreezeDuration = 5.0f;
+	bAttachFrozenCharacter = true;
+	TriggerAnimation = nullptr;
+	InitialCollisionEnabled = ECollisionEnabled::QueryAndPhysics;
+	bUseIdleMesh = false;
+}
+
+void AFreezeTrapPlatform::ApplyTuning(const UDoodlePlatformTuning& InTuning)
+{
+	FreezeDuration = InTuning.FreezeDuration;
+	bAttachFrozenCharacter = InTuning.bAttachFrozenCharacter;
+}
+
+void AFreezeTrapPlatform::BeginPlay()
+{
+	Super::BeginPlay();
+
+	InitialCollisionEnabled = PlatformMesh->GetCollisionEnabled();
+
+	bUseIdleMesh = FDoodlePlatformMeshSwap::CanUse(IdleMesh);
+	if (bUseIdleMesh)
+	{
+		FDoodlePlatformMeshSwap::SetIdle(PlatformMesh, IdleMesh, InitialCollisionEnabled);
+		RegisterContactComponent(IdleMesh);
+	}
+	else
+	{
+		IdleMesh->SetVisibility(false);
+	}
+
+	RegisterContactComponent(PlatformMesh);
+}
+
+void AFreezeTrapPlatform::HandleContact(const FDoodleContact& Contact)
+{
+	// A frozen character rests on the trap and keeps reporting contacts - those must not restart the freeze
+	const UDoodleMovementComponent* Movement = Contact.Character->GetDoodleMovement();
+	if (Contact.Side == EDoodleContactSide::Top && Movement && !Movement->IsFrozen())
+	{
+		Contact.Character->FreezeCharacter(FreezeDuration, bAttachFrozenCharacter ? this : nullptr);
+		PlayTriggerAnimation();
+	}
+}
+
+void AFreezeTrapPlatform::PlayTriggerAnimation()
+{
+	if (!TriggerAnimation)
+	{
+		return;
+	}
+
+	// Wake the skeletal mesh for the animation, and put it back to sleep once it has played
+	if (bUseIdleMesh)
+	{
+		FDoodlePlatformMeshSwap::SetAnimated(PlatformMesh, IdleMesh, InitialCollisionEnabled);
+	}
+
+	const float AnimDuration = FDoodlePlatformMeshSwap::PlayAnimation(PlatformMesh, TriggerAnimation);
+	if (bUseIdleMesh)
+	{
+		GetWorldTimerManager().SetTimer(AnimationTimerHandle, [this]()
+		{
+			FDoodlePlatformMeshSwap::SetIdle(PlatformMesh, IdleMesh, InitialCollisionEnabled);
+		}, FMath::Max(AnimDuration, UE_KINDA_SMALL_NUMBER), false);
+	}
+}
+
+void AFreezeTrapPlatform::ResetPlatform()
+{
+	GetWorldTimerManager().ClearTimer(AnimationTimerHandle);
+
+	FDoodlePlatformMeshSwap::StopAnimation(PlatformMesh);
+	if (bUseIdleMesh)
+	{
+		FDoodlePlatformMeshSwap::SetIdle(PlatformMesh, IdleMesh, InitialCollisionEnabled);
+	}
+}
@@ -2,26 +2,101 @@
 
 
 #include "LaunchpadPlatform.h"
+#include "DoodleCharacter.h"
+#include "DoodleContactSubsystem.h"
+#include "DoodleMovementComponent.h"
+#include "DoodlePlatformMeshSwap.h"
+#include "DoodlePlatformTuning.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "TimerManager.h"
 
-// Sets default values
 ALaunchpadPlatform::ALaunchpadPlatform()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	PlatformMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("PlatformMesh"));
+	RootComponent = PlatformMesh;
+	PlatformMesh->SetCollisionProfileName(TEXT("DoodleHazard"));
+	PlatformMesh->SetSimulatePhysics(false);
+	PlatformMesh->SetEnableGravity(false);
 
+	IdleMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("IdleMesh"));
+	IdleMesh->SetupAttachment(PlatformMesh);
+	IdleMesh->SetCollisionProfileName(TEXT("DoodleHazard"));
+	IdleMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	// Same boost the character applies by default (ADoodleCharacter::JumpBoostMultiplier)
+	BoostMultiplier = 1.5f;
+	LaunchAnimation = nullptr;
+	InitialCollisionEnabled = ECollisionEnabled::QueryAndPhysics;
+	bUseIdleMesh = false;
+}
+
+void ALaunchpadPlatform::ApplyTuning(const UDoodlePlatformTuning& InTuning)
+{
+	BoostMultiplier = InTuning.BoostMultiplier;
 }
 
-// Called when the game starts or when spawned
 void ALaunchpadPlatform::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	InitialCollisionEnabled = PlatformMesh->GetCollisionEnabled();
+
+	bUseIdleMesh = FDoodlePlatformMeshSwap::CanUse(IdleMesh);
+	if (bUseIdleMesh)
+	{
+		FDoodlePlatformMeshSwap::SetIdle(PlatformMesh, IdleMesh, InitialCollisionEnabled);
+		RegisterContactComponent(IdleMesh);
+	}
+	else
+	{
+		IdleMesh->SetVisibility(false);
+	}
+
+	RegisterContactComponent(PlatformMesh);
 }
 
-// Called every frame
-void ALaunchpadPlatform::Tick(float DeltaTime)
+void ALaunchpadPlatform::HandleContact(const FDoodleContact& Contact)
 {
-	Super::Tick(DeltaTime);
+	// The landing has already bounced the character this frame - the boost replaces that bounce
+	const UDoodleMovementComponent* Movement = Contact.Character->GetDoodleMovement();
+	if (Contact.Side == EDoodleContactSide::Top && Movement && !Movement->IsFrozen())
+	{
+		Contact.Character->ActivateJumpBoost(BoostMultiplier);
+		PlayLaunchAnimation();
+	}
+}
+
+void ALaunchpadPlatform::PlayLaunchAnimation()
+{
+	if (!LaunchAnimation)
+	{
+		return;
+	}
+
+	// Wake the skeletal mesh for the animation, and put it back to sleep once it has played
+	if (bUseIdleMesh)
+	{
+		FDoodlePlatformMeshSwap::SetAnimated(PlatformMesh, IdleMesh, InitialCollisionEnabled);
+	}
 
+	const float AnimDuration = FDoodlePlatformMeshSwap::PlayAnimation(PlatformMesh, LaunchAnimation);
+	if (bUseIdleMesh)
+	{
+		GetWorldTimerManager().SetTimer(AnimationTimerHandle, [this]()
+		{
+			FDoodlePlatformMeshSwap::SetIdle(PlatformMesh, IdleMesh, InitialCollisionEnabled);
+		}, FMath::Max(AnimDuration, UE_KINDA_SMALL_NUMBER), false);
+	}
 }
 
+void ALaunchpadPlatform::ResetPlatform()
+{
+	GetWorldTimerManager().ClearTimer(AnimationTimerHandle);
+
+	FDoodlePlatformMeshSwap::StopAnimation(PlatformMesh);
+	if (bUseIdleMesh)
+	{
+		FDoodlePlatformMeshSwap::SetIdle(PlatformMesh, IdleMesh, InitialCollisionEnabled);
+	}
+}
@@ -1,10 +1,14 @@
 #include "MovingPlatform.h"
 #include "Components/StaticMeshComponent.h"
 #include "MovementPoint.h"
+#include "MovingPlatformSubsystem.h"
+#include "DoodleHeightIndexSubsystem.h"
+#include "DoodleJump.h"
 
 AMovingPlatform::AMovingPlatform()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Movement is driven in batch by UMovingPlatformSubsystem
+	PrimaryActorTick.bCanEverTick = false;
 
 	PlatformMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("PlatformMesh"));
 	RootComponent = PlatformMesh;
@@ -13,114 +17,106 @@ AMovingPlatform::AMovingPlatform()
 
 	Speed = 200.0f;
 	bLoopMovement = true;
-	CurrentPointIndex = 0;
-	bMovingForward = true;
+	ManagerIndex = INDEX_NONE;
+	HeightIndexHandle = INDEX_NONE;
 }
 
 void AMovingPlatform::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// Platforms spawned by another actor (the tower generator) are indexed by their owner
+	if (!GetOwner())
+	{
+		if (UDoodleHeightIndexSubsystem* HeightIndex = GetWorld()->GetSubsystem<UDoodleHeightIndexSubsystem>())
+		{
+			HeightIndexHandle = HeightIndex->AddActor(this, DHC_Platform, true);
+		}
+	}
+
+	// Already given explicit points (e.g. by the tower generator) before BeginPlay
+	if (ManagerIndex != INDEX_NONE)
+	{
+		return;
+	}
+
 	if (MovementPoints.Num() == 0)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("MovingPlatform '%s': No movement points assigned!"), *GetName());
-		SetActorTickEnabled(false);
+		UE_LOG(LogDoodleJump, Warning, TEXT("MovingPlatform '%s': No movement points assigned!"), *GetName());
 		return;
 	}
 
 	// FIRST: Attach all objects BEFORE teleporting the platform
-	// This way they will teleport together with the platform
+	// This way they will teleport together with the platform. Attachment is the kinematic carry: they move in the
+	// platform's transform update without sweeping, and their ticks wait for the update so they never lag a frame.
+	UMovingPlatformSubsystem* PlatformSubsystem = GetWorld()->GetSubsystem<UMovingPlatformSubsystem>();
 	for (AActor* AttachedObject : AttachedObjects)
 	{
 		if (AttachedObject)
 		{
 			AttachedObject->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
-			UE_LOG(LogTemp, Log, TEXT("Attached '%s' to MovingPlatform '%s'"), *AttachedObject->GetName(), *GetName());
+			if (PlatformSubsystem)
+			{
+				PlatformSubsystem->AddTickDependency(AttachedObject);
+			}
+			UE_LOG(LogDoodleJump, Verbose, TEXT("Attached '%s' to MovingPlatform '%s'"), *AttachedObject->GetName(), *GetName());
 		}
 	}
 
 	// THEN: Teleport platform to first point (attached objects will move with it)
-	if (MovementPoints[0])
-	{
-		SetActorLocation(MovementPoints[0]->GetActorLocation());
-	}
-
-	// Start moving towards the second point (index 1)
-	CurrentPointIndex = 1;
+	// and hand the path over to the batched manager, which starts moving towards the second point
+	TArray<FVector> PathPoints;
+	GetPathPoints(PathPoints);
+	SetPathPoints(PathPoints);
 
-	UE_LOG(LogTemp, Log, TEXT("MovingPlatform '%s' initialized with %d points, Speed: %.2f, Loop: %s, Attached Objects: %d"),
+	UE_LOG(LogDoodleJump, Verbose, TEXT("MovingPlatform '%s' initialized with %d points, Speed: %.2f, Loop: %s, Attached Objects: %d"),
 		*GetName(), MovementPoints.Num(), Speed, bLoopMovement ? TEXT("YES") : TEXT("NO"), AttachedObjects.Num());
 }
 
-void AMovingPlatform::Tick(float DeltaTime)
+void AMovingPlatform::SetPathPoints(TConstArrayView<FVector> WorldPoints)
 {
-	Super::Tick(DeltaTime);
-
-	if (MovementPoints.Num() < 2)
+	if (UMovingPlatformSubsystem* PlatformSubsystem = GetWorld()->GetSubsystem<UMovingPlatformSubsystem>())
 	{
-		return;
-	}
+		if (WorldPoints.Num() > 0)
+		{
+			SetActorLocation(WorldPoints[0]);
+		}
 
-	MoveTowardsTarget(DeltaTime);
+		PlatformSubsystem->RegisterPlatform(this, WorldPoints, Speed, bLoopMovement);
+	}
 }
 
-void AMovingPlatform::MoveTowardsTarget(float DeltaTime)
+void AMovingPlatform::GetPathPoints(TArray<FVector>& OutPoints) const
 {
-	// Validate current target point
-	if (!MovementPoints.IsValidIndex(CurrentPointIndex) || !MovementPoints[CurrentPointIndex])
+	OutPoints.Reset(MovementPoints.Num());
+	for (const AMovementPoint* MovementPoint : MovementPoints)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("MovingPlatform '%s': Invalid movement point at index %d"), *GetName(), CurrentPointIndex);
-		return;
-	}
-
-	FVector CurrentLocation = GetActorLocation();
-	FVector TargetLocation = MovementPoints[CurrentPointIndex]->GetActorLocation();
-	FVector Direction = (TargetLocation - CurrentLocation).GetSafeNormal();
-	float DistanceToTarget = FVector::Dist(CurrentLocation, TargetLocation);
-
-	float StepDistance = Speed * DeltaTime;
-
-	// Check if we reached the target
-	if (DistanceToTarget <= StepDistance)
-	{
-		// Snap to target
-		SetActorLocation(TargetLocation);
-
-		// Move to next point
-		if (bMovingForward)
+		if (MovementPoint)
 		{
-			CurrentPointIndex++;
-			if (CurrentPointIndex >= MovementPoints.Num())
-			{
-				if (bLoopMovement)
-				{
-					// Loop back to start
-					CurrentPointIndex = 0;
-				}
-				else
-				{
-					// Reverse direction
-					CurrentPointIndex = MovementPoints.Num() - 2;
-					bMovingForward = false;
-				}
-			}
+			OutPoints.Add(MovementPoint->GetActorLocation());
 		}
 		else
 		{
-			CurrentPointIndex--;
-			if (CurrentPointIndex < 0)
-			{
-				// Reverse direction
-				CurrentPointIndex = 1;
-				bMovingForward = true;
-			}
+			UE_LOG(LogDoodleJump, Warning, TEXT("MovingPlatform '%s': Skipping empty movement point"), *GetName());
 		}
 	}
-	else
+}
+
+void AMovingPlatform::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UMovingPlatformSubsystem* PlatformSubsystem = GetWorld()->GetSubsystem<UMovingPlatformSubsystem>())
+	{
+		PlatformSubsystem->UnregisterPlatform(this);
+		for (AActor* AttachedObject : AttachedObjects)
+		{
+			PlatformSubsystem->RemoveTickDependency(AttachedObject);
+		}
+	}
+
+	if (UDoodleHeightIndexSubsystem* HeightIndex = GetWorld()->GetSubsystem<UDoodleHeightIndexSubsystem>())
 	{
-		// Move towards target
-		FVector NewLocation = CurrentLocation + (Direction * StepDistance);
-		SetActorLocation(NewLocation);
+		HeightIndex->Remove(HeightIndexHandle);
 	}
-}
 
+	Super::EndPlay(EndPlayReason);
+}
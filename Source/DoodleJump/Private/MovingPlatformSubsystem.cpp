@@ -0,0 +1,419 @@
+#include "MovingPlatformSubsystem.h"
+#include "MovingPlatform.h"
+#include "DoodleBenchmark.h"
+#include "DoodleJump.h"
+#include "DoodleSignificanceSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+
+void FMovingPlatformTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem)
+	{
+		Subsystem->UpdatePlatforms(DeltaTime);
+	}
+}
+
+FString FMovingPlatformTickFunction::DiagnosticMessage()
+{
+	return TEXT("UMovingPlatformSubsystem update");
+}
+
+UMovingPlatformSubsystem::UMovingPlatformSubsystem()
+{
+	ParallelUpdateThreshold = 256;
+
+	PlatformTickFunction.TickGroup = TG_PrePhysics;
+	PlatformTickFunction.EndTickGroup = TG_PrePhysics;
+	PlatformTickFunction.bHighPriority = true;
+	PlatformTickFunction.bCanEverTick = true;
+	PlatformTickFunction.bStartWithTickEnabled = true;
+}
+
+bool UMovingPlatformSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UMovingPlatformSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	PlatformTickFunction.Subsystem = this;
+	PlatformTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UMovingPlatformSubsystem::Deinitialize()
+{
+	if (PlatformTickFunction.IsTickFunctionRegistered())
+	{
+		PlatformTickFunction.UnRegisterTickFunction();
+	}
+	PlatformTickFunction.Subsystem = nullptr;
+
+	for (AMovingPlatform* Platform : Platforms)
+	{
+		if (Platform)
+		{
+			Platform->ManagerIndex = INDEX_NONE;
+		}
+	}
+
+	Platforms.Empty();
+	Locations.Empty();
+	Speeds.Empty();
+	StartTimes.Empty();
+	PathStarts.Empty();
+	PathCounts.Empty();
+	SegmentHints.Empty();
+	Flags.Empty();
+	NextUpdateTimes.Empty();
+	PathPoints.Empty();
+	CumulativeDistances.Empty();
+	Riders.Empty();
+
+	Super::Deinitialize();
+}
+
+void UMovingPlatformSubsystem::RegisterPlatform(AMovingPlatform* Platform, TConstArrayView<FVector> Waypoints, float Speed, bool bLoop)
+{
+	if (!Platform || Waypoints.Num() < 2)
+	{
+		return;
+	}
+
+	if (Platform->ManagerIndex != INDEX_NONE)
+	{
+		UnregisterPlatform(Platform);
+	}
+
+	// Bake the path: looping paths get the first point appended so the closing segment is a regular one
+	const int32 PathStart = PathPoints.Num();
+	PathPoints.Append(Waypoints.GetData(), Waypoints.Num());
+	if (bLoop)
+	{
+		PathPoints.Add(Waypoints[0]);
+	}
+	const int32 PathCount = PathPoints.Num() - PathStart;
+
+	float Distance = 0.0f;
+	CumulativeDistances.Add(0.0f);
+	for (int32 PointIndex = PathStart + 1; PointIndex < PathStart + PathCount; ++PointIndex)
+	{
+		Distance += FVector::Dist(PathPoints[PointIndex - 1], PathPoints[PointIndex]);
+		CumulativeDistances.Add(Distance);
+	}
+
+	Platform->ManagerIndex = Platforms.Add(Platform);
+	Locations.Add(Waypoints[0]);
+	Speeds.Add(Speed);
+	StartTimes.Add(GetWorld()->GetTimeSeconds());
+	PathStarts.Add(PathStart);
+	PathCounts.Add(PathCount);
+	SegmentHints.Add(0);
+	Flags.Add(bLoop ? PF_Loop : 0);
+	NextUpdateTimes.Add(0.0);
+}
+
+void UMovingPlatformSubsystem::UnregisterPlatform(AMovingPlatform* Platform)
+{
+	if (!Platform || !Platforms.IsValidIndex(Platform->ManagerIndex) || Platforms[Platform->ManagerIndex] != Platform)
+	{
+		return;
+	}
+
+	const int32 Index = Platform->ManagerIndex;
+	Platform->ManagerIndex = INDEX_NONE;
+
+	// Compact the packed path arrays and shift the ranges behind the removed one
+	const int32 RemovedStart = PathStarts[Index];
+	const int32 RemovedCount = PathCounts[Index];
+	PathPoints.RemoveAt(RemovedStart, RemovedCount, EAllowShrinking::No);
+	CumulativeDistances.RemoveAt(RemovedStart, RemovedCount, EAllowShrinking::No);
+	for (int32& Start : PathStarts)
+	{
+		if (Start > RemovedStart)
+		{
+			Start -= RemovedCount;
+		}
+	}
+
+	Platforms.RemoveAtSwap(Index, EAllowShrinking::No);
+	Locations.RemoveAtSwap(Index, EAllowShrinking::No);
+	Speeds.RemoveAtSwap(Index, EAllowShrinking::No);
+	StartTimes.RemoveAtSwap(Index, EAllowShrinking::No);
+	PathStarts.RemoveAtSwap(Index, EAllowShrinking::No);
+	PathCounts.RemoveAtSwap(Index, EAllowShrinking::No);
+	SegmentHints.RemoveAtSwap(Index, EAllowShrinking::No);
+	Flags.RemoveAtSwap(Index, EAllowShrinking::No);
+	NextUpdateTimes.RemoveAtSwap(Index, EAllowShrinking::No);
+
+	if (Platforms.IsValidIndex(Index) && Platforms[Index])
+	{
+		Platforms[Index]->ManagerIndex = Index;
+	}
+}
+
+void UMovingPlatformSubsystem::RestartPaths()
+{
+	const double Time = GetWorld()->GetTimeSeconds();
+	for (int32 Index = 0; Index < Platforms.Num(); ++Index)
+	{
+		StartTimes[Index] = Time;
+		SegmentHints[Index] = 0;
+		NextUpdateTimes[Index] = 0.0;
+		Locations[Index] = PathPoints[PathStarts[Index]];
+		Flags[Index] |= PF_Moved | PF_Evaluated;
+	}
+
+	// Moved now rather than on the next Tick, so nothing sees the old positions
+	ApplyTransforms();
+}
+
+void UMovingPlatformSubsystem::AddTickDependency(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	Actor->PrimaryActorTick.AddPrerequisite(this, PlatformTickFunction);
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		Component->PrimaryComponentTick.AddPrerequisite(this, PlatformTickFunction);
+	}
+}
+
+void UMovingPlatformSubsystem::RemoveTickDependency(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	Actor->PrimaryActorTick.RemovePrerequisite(this, PlatformTickFunction);
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		Component->PrimaryComponentTick.RemovePrerequisite(this, PlatformTickFunction);
+	}
+}
+
+AMovingPlatform* UMovingPlatformSubsystem::FindCarrier(const AActor* Actor) const
+{
+	for (; Actor; Actor = Actor->GetAttachParentActor())
+	{
+		const AMovingPlatform* Platform = Cast<AMovingPlatform>(Actor);
+		if (Platform && Platforms.IsValidIndex(Platform->ManagerIndex) && Platforms[Platform->ManagerIndex] == Platform)
+		{
+			return Platforms[Platform->ManagerIndex];
+		}
+	}
+	return nullptr;
+}
+
+bool UMovingPlatformSubsystem::AddRider(USceneComponent* Rider, const AActor* Attachment, const FVector& AttachmentOffset)
+{
+	AMovingPlatform* Platform = FindCarrier(Attachment);
+	if (!Rider || !Platform)
+	{
+		return false;
+	}
+
+	RemoveRider(Rider);
+
+	// Attached actors move rigidly with their platform, so the offset holds for as long as the ride lasts
+	FRider& NewRider = Riders.AddDefaulted_GetRef();
+	NewRider.Component = Rider;
+	NewRider.Platform = Platform;
+	NewRider.Offset = Attachment->GetActorLocation() - Platform->GetActorLocation() + AttachmentOffset;
+	return true;
+}
+
+void UMovingPlatformSubsystem::RemoveRider(USceneComponent* Rider)
+{
+	for (int32 Index = Riders.Num() - 1; Index >= 0; --Index)
+	{
+		if (Riders[Index].Component == Rider)
+		{
+			Riders.RemoveAtSwap(Index, EAllowShrinking::No);
+		}
+	}
+}
+
+FVector UMovingPlatformSubsystem::EvaluatePlatformLocation(const AMovingPlatform* Platform, double Time) const
+{
+	if (!Platform || !Platforms.IsValidIndex(Platform->ManagerIndex))
+	{
+		return Platform ? Platform->GetActorLocation() : FVector::ZeroVector;
+	}
+
+	const int32 Index = Platform->ManagerIndex;
+	const int32 PathStart = PathStarts[Index];
+	int32 SegmentHint = SegmentHints[Index];
+
+	return EvaluatePath(PathPoints.GetData() + PathStart, CumulativeDistances.GetData() + PathStart, PathCounts[Index],
+		(Flags[Index] & PF_Loop) != 0, (Time - StartTimes[Index]) * Speeds[Index], SegmentHint);
+}
+
+FVector UMovingPlatformSubsystem::EvaluatePath(const FVector* Points, const float* Distances, int32 NumPoints,
+	bool bLoop, double TravelDistance, int32& SegmentHint)
+{
+	const double PathLength = Distances[NumPoints - 1];
+	if (PathLength <= UE_KINDA_SMALL_NUMBER)
+	{
+		return Points[0];
+	}
+
+	// Fold the travelled distance onto the path: wrap around for loops, mirror for ping-pong.
+	// Negative distances wrap by the mode's own period - a ping-pong path repeats every two lengths.
+	const double Period = bLoop ? PathLength : 2.0 * PathLength;
+	double PathDistance = FMath::Fmod(TravelDistance, Period);
+	if (PathDistance < 0.0)
+	{
+		PathDistance += Period;
+	}
+	if (!bLoop && PathDistance > PathLength)
+	{
+		PathDistance = 2.0 * PathLength - PathDistance;
+	}
+
+	// Walk from the previous segment - platforms rarely cross more than one waypoint per update
+	const int32 LastSegment = NumPoints - 2;
+	int32 Segment = FMath::Clamp(SegmentHint, 0, LastSegment);
+	while (Segment < LastSegment && PathDistance > Distances[Segment + 1])
+	{
+		++Segment;
+	}
+	while (Segment > 0 && PathDistance < Distances[Segment])
+	{
+		--Segment;
+	}
+	SegmentHint = Segment;
+
+	const double SegmentLength = Distances[Segment + 1] - Distances[Segment];
+	const double Alpha = SegmentLength > UE_KINDA_SMALL_NUMBER ? (PathDistance - Distances[Segment]) / SegmentLength : 0.0;
+	return FMath::Lerp(Points[Segment], Points[Segment + 1], FMath::Clamp(Alpha, 0.0, 1.0));
+}
+
+void UMovingPlatformSubsystem::UpdatePlatforms(float DeltaTime)
+{
+	DOODLE_BENCHMARK_TICK_SCOPE("UMovingPlatformSubsystem");
+	SCOPE_CYCLE_COUNTER(STAT_DoodleMovingPlatforms);
+	CSV_SCOPED_TIMING_STAT(DoodleJump, MovingPlatforms);
+
+	const int32 NumPlatforms = Platforms.Num();
+	SET_DWORD_STAT(STAT_DoodleMovingPlatformCount, NumPlatforms);
+	CSV_CUSTOM_STAT(DoodleJump, MovingPlatformCount, NumPlatforms, ECsvCustomStatOp::Set);
+	if (NumPlatforms == 0)
+	{
+		return;
+	}
+
+	const double Time = GetWorld()->GetTimeSeconds();
+	const UDoodleSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UDoodleSignificanceSubsystem>();
+	if (Significance && !Significance->HasViewer())
+	{
+		Significance = nullptr;
+	}
+
+	// Pass 1: evaluate all platforms on plain data only
+	if (NumPlatforms >= ParallelUpdateThreshold)
+	{
+		ParallelFor(NumPlatforms, [this, Time, Significance](int32 Index)
+		{
+			UpdatePlatform(Index, Time, Significance);
+		});
+	}
+	else
+	{
+		for (int32 Index = 0; Index < NumPlatforms; ++Index)
+		{
+			UpdatePlatform(Index, Time, Significance);
+		}
+	}
+
+	// Pass 2: push the results to the actors and their riders on the game thread
+	ApplyTransforms();
+}
+
+void UMovingPlatformSubsystem::UpdatePlatform(int32 Index, double Time, const UDoodleSignificanceSubsystem* Significance)
+{
+	// Distant platforms are evaluated less often and platforms far below not at all.
+	// The closed-form path puts them back in the right place whenever they are evaluated again.
+	if (Significance)
+	{
+		float UpdateInterval;
+		if (Significance->ClassifyHeight(Locations[Index].Z, UpdateInterval) == EDoodleSignificance::Culled || Time < NextUpdateTimes[Index])
+		{
+			return;
+		}
+		NextUpdateTimes[Index] = Time + UpdateInterval;
+	}
+
+	Flags[Index] |= PF_Evaluated;
+
+	const int32 PathStart = PathStarts[Index];
+	const FVector NewLocation = EvaluatePath(PathPoints.GetData() + PathStart, CumulativeDistances.GetData() + PathStart,
+		PathCounts[Index], (Flags[Index] & PF_Loop) != 0, (Time - StartTimes[Index]) * Speeds[Index], SegmentHints[Index]);
+
+	if (!NewLocation.Equals(Locations[Index]))
+	{
+		Locations[Index] = NewLocation;
+		Flags[Index] |= PF_Moved;
+	}
+}
+
+void UMovingPlatformSubsystem::ApplyTransforms()
+{
+	int32 NumSkipped = 0;
+
+	const int32 NumPlatforms = Platforms.Num();
+	for (int32 Index = 0; Index < NumPlatforms; ++Index)
+	{
+		if (!(Flags[Index] & PF_Evaluated))
+		{
+			NumSkipped++;
+		}
+
+		if (!(Flags[Index] & PF_Moved))
+		{
+			Flags[Index] &= ~PF_Evaluated;
+			continue;
+		}
+
+		Flags[Index] &= ~(PF_Moved | PF_Evaluated);
+
+		if (AMovingPlatform* Platform = Platforms[Index])
+		{
+			Platform->SetActorLocation(Locations[Index]);
+		}
+	}
+
+	INC_FLOAT_STAT_BY(STAT_DoodleTicksSkipped, static_cast<float>(NumSkipped));
+
+	MoveRiders();
+}
+
+void UMovingPlatformSubsystem::MoveRiders()
+{
+	for (int32 Index = Riders.Num() - 1; Index >= 0; --Index)
+	{
+		const FRider& Rider = Riders[Index];
+		USceneComponent* Component = Rider.Component.Get();
+		const AMovingPlatform* Platform = Rider.Platform.Get();
+		if (!Component || !Platform || Platform->ManagerIndex == INDEX_NONE)
+		{
+			Riders.RemoveAtSwap(Index, EAllowShrinking::No);
+			continue;
+		}
+
+		// Kinematic: the platform already decided where it goes, nothing on the way can stop the rider
+		const FVector Target = Platform->GetActorLocation() + Rider.Offset;
+		if (!Target.Equals(Component->GetComponentLocation()))
+		{
+			Component->SetWorldLocation(Target, false, nullptr, ETeleportType::None);
+		}
+	}
+}
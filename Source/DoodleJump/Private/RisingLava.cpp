@@ -0,0 +1,197 @@
+#include "RisingLava.h"
+#include "DoodleBenchmark.h"
+#include "DoodleCharacter.h"
+#include "DoodleCheckpointSubsystem.h"
+#include "DoodleJump.h"
+#include "DoodleSignificanceSubsystem.h"
+#include "DoodleTrace.h"
+#include "DoodleWorldResetSubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Kismet/GameplayStatics.h"
+
+ARisingLava::ARisingLava()
+{
+	// After movement, so the player is compared at their final position for the frame
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PostPhysics;
+
+	// Purely visual - moving it must not cost overlap or physics updates
+	Surface = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Surface"));
+	RootComponent = Surface;
+	Surface->SetMobility(EComponentMobility::Movable);
+	Surface->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Surface->SetGenerateOverlapEvents(false);
+	Surface->SetCastShadow(false);
+
+	StartDelay = 3.0f;
+	RiseSpeed = 50.0f;
+	RiseAcceleration = 2.0f;
+	MaxRiseSpeed = 600.0f;
+	Difficulty = 1.0f;
+	KillDepth = 0.0f;
+
+	InitialHeight = 0.0;
+	InitialDifficulty = 1.0f;
+	BaseHeight = 0.0;
+	RunStartTime = 0.0;
+	LavaHeight = 0.0;
+}
+
+void ARisingLava::BeginPlay()
+{
+	Super::BeginPlay();
+
+	InitialHeight = GetActorLocation().Z;
+	InitialDifficulty = Difficulty;
+	BaseHeight = InitialHeight;
+	RunStartTime = GetWorld()->GetTimeSeconds();
+	LavaHeight = InitialHeight;
+
+	if (UDoodleWorldResetSubsystem* Reset = GetWorld()->GetSubsystem<UDoodleWorldResetSubsystem>())
+	{
+		Reset->RegisterResettable(this, FSimpleDelegate::CreateUObject(this, &ARisingLava::ResetLava));
+	}
+
+	if (UDoodleCheckpointSubsystem* Checkpoints = GetWorld()->GetSubsystem<UDoodleCheckpointSubsystem>())
+	{
+		Checkpoints->RegisterCheckpointed(this, FDoodleCheckpointDelegate::CreateUObject(this, &ARisingLava::SerializeCheckpoint));
+	}
+
+	if (UDoodleSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UDoodleSignificanceSubsystem>())
+	{
+		Significance->SetCullFloor(LavaHeight);
+	}
+}
+
+void ARisingLava::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UDoodleWorldResetSubsystem* Reset = GetWorld()->GetSubsystem<UDoodleWorldResetSubsystem>())
+	{
+		Reset->UnregisterResettable(this);
+	}
+
+	if (UDoodleCheckpointSubsystem* Checkpoints = GetWorld()->GetSubsystem<UDoodleCheckpointSubsystem>())
+	{
+		Checkpoints->UnregisterCheckpointed(this);
+	}
+
+	if (UDoodleSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UDoodleSignificanceSubsystem>())
+	{
+		Significance->SetCullFloor(-UE_BIG_NUMBER);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+double ARisingLava::GetRiseDistance(double T) const
+{
+	if (T <= 0.0)
+	{
+		return 0.0;
+	}
+
+	const double Speed = FMath::Max(MaxRiseSpeed > 0.0f ? FMath::Min(RiseSpeed, MaxRiseSpeed) : RiseSpeed, 0.0f);
+	if (RiseAcceleration > 0.0f && MaxRiseSpeed > 0.0f)
+	{
+		// Accelerates until MaxRiseSpeed, then rises at that speed
+		const double CapTime = (MaxRiseSpeed - Speed) / RiseAcceleration;
+		if (T > CapTime)
+		{
+			return Speed * CapTime + 0.5 * RiseAcceleration * CapTime * CapTime + MaxRiseSpeed * (T - CapTime);
+		}
+	}
+	else if (RiseAcceleration < 0.0f)
+	{
+		// Decelerates until it stops, then stays there
+		T = FMath::Min(T, Speed / -RiseAcceleration);
+	}
+
+	return FMath::Max(Speed * T + 0.5 * RiseAcceleration * T * T, 0.0);
+}
+
+float ARisingLava::GetLavaHeightAtTime(float WorldTime) const
+{
+	return static_cast<float>(BaseHeight + Difficulty * GetRiseDistance(WorldTime - RunStartTime - StartDelay));
+}
+
+void ARisingLava::SetDifficulty(float NewDifficulty)
+{
+	const double T = GetWorld()->GetTimeSeconds() - RunStartTime - StartDelay;
+	const double Height = BaseHeight + Difficulty * GetRiseDistance(T);
+
+	BaseHeight = Height - NewDifficulty * GetRiseDistance(T);
+	Difficulty = NewDifficulty;
+}
+
+void ARisingLava::UpdateHeight(double Time)
+{
+	LavaHeight = BaseHeight + Difficulty * GetRiseDistance(Time - RunStartTime - StartDelay);
+
+	FVector Location = GetActorLocation();
+	if (Location.Z != LavaHeight)
+	{
+		Location.Z = LavaHeight;
+		SetActorLocation(Location);
+	}
+
+	if (UDoodleSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UDoodleSignificanceSubsystem>())
+	{
+		Significance->SetCullFloor(LavaHeight);
+	}
+}
+
+void ARisingLava::Tick(float DeltaTime)
+{
+	DOODLE_BENCHMARK_TICK_SCOPE("ARisingLava");
+	SCOPE_CYCLE_COUNTER(STAT_DoodleLava);
+	CSV_SCOPED_TIMING_STAT(DoodleJump, Lava);
+
+	Super::Tick(DeltaTime);
+
+	UpdateHeight(GetWorld()->GetTimeSeconds());
+
+	ADoodleCharacter* Character = Cast<ADoodleCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+	if (!Character)
+	{
+		return;
+	}
+
+	const double FeetHeight = Character->GetActorLocation().Z - Character->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	if (FeetHeight >= LavaHeight - KillDepth)
+	{
+		return;
+	}
+
+	DOODLE_TRACE(LavaKill, Character, this, static_cast<float>(LavaHeight), static_cast<float>(FeetHeight));
+
+	// Restarting also resets the lava
+	if (UDoodleWorldResetSubsystem* Reset = GetWorld()->GetSubsystem<UDoodleWorldResetSubsystem>())
+	{
+		Reset->ResetWorld();
+	}
+}
+
+void ARisingLava::SerializeCheckpoint(FArchive& Ar)
+{
+	// Time into the run rather than the start time, since the world clock keeps going after the capture
+	const double Time = GetWorld()->GetTimeSeconds();
+	float Base = static_cast<float>(BaseHeight);
+	float RunTime = static_cast<float>(Time - RunStartTime);
+	Ar << Base << Difficulty << RunTime;
+
+	if (Ar.IsLoading())
+	{
+		BaseHeight = Base;
+		RunStartTime = Time - RunTime;
+		UpdateHeight(Time);
+	}
+}
+
+void ARisingLava::ResetLava()
+{
+	Difficulty = InitialDifficulty;
+	BaseHeight = InitialHeight;
+	RunStartTime = GetWorld()->GetTimeSeconds();
+	UpdateHeight(RunStartTime);
+}
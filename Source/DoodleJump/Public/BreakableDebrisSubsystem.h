@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BreakableDebrisSubsystem.generated.h"
+
+class ABreakablePlatform;
+
+// Owns broken ABreakablePlatforms while they fall as rigid bodies.
+// Caps how many simulate at once and retires debris that drops below the kill height, leaves the view
+// or exceeds its simulation time. Retired platforms stop simulating and are hidden until ResetPlatform.
+UCLASS(Config = Game)
+class DOODLEJUMP_API UBreakableDebrisSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UBreakableDebrisSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Called when a platform starts simulating; retires the oldest debris when over the cap
+	void AddDebris(ABreakablePlatform* Platform);
+	void RemoveDebris(ABreakablePlatform* Platform);
+
+	int32 GetNumSimulating() const { return Debris.Num(); }
+
+protected:
+	// Broken platforms allowed to simulate at the same time
+	UPROPERTY(Config)
+	int32 MaxSimulatingDebris;
+
+	// Seconds a broken platform may simulate at most
+	UPROPERTY(Config)
+	float MaxSimulationTime;
+
+	// Debris this far below the player is retired (the world KillZ always applies)
+	UPROPERTY(Config)
+	float KillDistanceBelowPlayer;
+
+	// Debris not rendered for this long is retired
+	UPROPERTY(Config)
+	float OffscreenTimeout;
+
+private:
+	// Oldest first
+	UPROPERTY()
+	TArray<ABreakablePlatform*> Debris;
+
+	TArray<double> StartTimes;
+
+	int32 NumRetiredThisFrame;
+
+	void RetireAt(int32 Index);
+};
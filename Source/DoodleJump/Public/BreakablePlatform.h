@@ -1,23 +1,36 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "GameFramework/Actor.h"
+#include "DoodlePlatformBase.h"
 #include "BreakablePlatform.generated.h"
 
 class USkeletalMeshComponent;
+class UStaticMeshComponent;
 class UBoxComponent;
 class UAnimSequenceBase;
+class UBreakableDebrisSubsystem;
 
 UCLASS()
-class DOODLEJUMP_API ABreakablePlatform : public AActor
+class DOODLEJUMP_API ABreakablePlatform : public ADoodlePlatformBase
 {
 	GENERATED_BODY()
 
 public:
 	ABreakablePlatform();
 
+	bool IsBroken() const { return bIsBroken; }
+
+	// Put the platform back together where it was placed, ready to be broken again
+	virtual void ResetPlatform() override;
+	virtual void SetHomeTransform(const FTransform& Transform) override { InitialTransform = Transform; }
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void ApplyTuning(const UDoodlePlatformTuning& InTuning) override;
+
+	// Landing on it or bumping it from below breaks it, brushing the side does not
+	virtual void HandleContact(const FDoodleContact& Contact) override;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	USkeletalMeshComponent* PlatformMesh;
@@ -25,6 +38,10 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	UBoxComponent* CollisionBox;
 
+	// Static stand-in for PlatformMesh while the platform is intact. Leave its mesh empty to always use the skeletal mesh.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UStaticMeshComponent* IdleMesh;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
 	float BreakDelay;
 
@@ -38,11 +55,29 @@ protected:
 	bool bUsePhysics;
 
 private:
+	friend class UBreakableDebrisSubsystem;
+	friend class UDoodleCheckpointSubsystem;
+
 	FTimerHandle BreakTimerHandle;
 	FTimerHandle PhysicsTimerHandle;
 
-	UFUNCTION()
-	void OnPlatformHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+	// State captured at BeginPlay and restored by ResetPlatform; the transform follows SetHomeTransform
+	FTransform InitialTransform;
+	ECollisionEnabled::Type InitialCollisionEnabled;
+	FName InitialCollisionProfile;
+
+	// IdleMesh stands in for PlatformMesh until the break animation starts
+	bool bUseIdleMesh;
+
+	// Debris lifecycle - start simulating and hand the platform to UBreakableDebrisSubsystem
+	void StartFalling();
+	void RegisterDebris();
+
+	// Called by UBreakableDebrisSubsystem: stop simulating and hide until ResetPlatform
+	void RetireDebris();
 
 	void BreakPlatform();
+
+	// Checkpoint restore: broken and already fallen out of the level
+	void RestoreBroken();
 };
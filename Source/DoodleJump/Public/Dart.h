@@ -8,6 +8,8 @@
 
 class UStaticMeshComponent;
 class UCapsuleComponent;
+class UDartPoolSubsystem;
+struct FDoodleContact;
 
 UCLASS()
 class DOODLEJUMP_API ADart : public AActor
@@ -19,8 +21,15 @@ public:
 
 	virtual void Tick(float DeltaTime) override;
 
+	// Pool lifecycle - called by UDartPoolSubsystem only
+	void ActivateFromPool(const FTransform& SpawnTransform);
+	void DeactivateToPool();
+
+	bool IsPooled() const { return bIsPooled; }
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// Components
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -45,6 +54,29 @@ protected:
 	float Lifetime;
 
 private:
-	UFUNCTION()
-	void OnCapsuleHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+	friend class UDartPoolSubsystem;
+	friend class UDartProjectileSubsystem;
+	friend class UDoodleCheckpointSubsystem;
+
+	// True when the dart is owned by UDartPoolSubsystem and must be released instead of destroyed
+	bool bIsPooled;
+
+	// True while a pooled dart sits deactivated in the pool
+	bool bIsInPool;
+
+	// Time since the dart was spawned or taken from the pool
+	float ActiveTime;
+
+	// Return to pool (pooled darts) or destroy (directly spawned darts)
+	void Expire();
+
+	// Entry in UDoodleHeightIndexSubsystem while the dart is in flight
+	int32 HeightIndexHandle;
+
+	// Tick throttling by distance to the player and the height index while the dart is in flight; culled darts expire
+	void RegisterInFlight();
+	void UnregisterInFlight();
+
+	// One classified contact per character per frame, from UDoodleContactSubsystem
+	void HandleContact(const FDoodleContact& Contact);
 };
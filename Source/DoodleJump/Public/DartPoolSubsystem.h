@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DartPoolSubsystem.generated.h"
+
+class ADart;
+
+USTRUCT(BlueprintType)
+struct FDartPoolStats
+{
+	GENERATED_BODY()
+
+	// Darts owned by the pool (active + free)
+	UPROPERTY(BlueprintReadOnly, Category = "Dart Pool")
+	int32 PooledCount = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Dart Pool")
+	int32 ActiveCount = 0;
+
+	// Highest number of simultaneously active darts
+	UPROPERTY(BlueprintReadOnly, Category = "Dart Pool")
+	int32 HighWaterMark = 0;
+
+	// Acquires that found no free dart and had to spawn a new one
+	UPROPERTY(BlueprintReadOnly, Category = "Dart Pool")
+	int32 Misses = 0;
+};
+
+USTRUCT()
+struct FDartPoolBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<ADart*> AllDarts;
+
+	UPROPERTY()
+	TArray<ADart*> FreeDarts;
+
+	FDartPoolStats Stats;
+};
+
+// Keeps a pre-warmed pool of darts per class so traps never spawn or destroy dart actors in steady state
+UCLASS(Config = Game)
+class DOODLEJUMP_API UDartPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UDartPoolSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Spawn darts ahead of time so the first volleys do not hitch
+	UFUNCTION(BlueprintCallable, Category = "Dart Pool")
+	void PrewarmPool(TSubclassOf<ADart> DartClass, int32 Count);
+
+	// Take a dart from the pool and place it at SpawnTransform. Spawns a new dart (a miss) if the pool is empty.
+	// FlightTime starts it that many seconds along its path; returns null if it would already have expired.
+	UFUNCTION(BlueprintCallable, Category = "Dart Pool")
+	ADart* AcquireDart(TSubclassOf<ADart> DartClass, const FTransform& SpawnTransform, float FlightTime = 0.0f);
+
+	// Deactivate the dart and make it available again
+	void ReleaseDart(ADart* Dart);
+
+	// Release every active dart of every class (world reset)
+	void ReleaseAllDarts();
+
+	UFUNCTION(BlueprintCallable, Category = "Dart Pool")
+	FDartPoolStats GetPoolStats(TSubclassOf<ADart> DartClass) const;
+
+	// Stats summed over every dart class, except HighWaterMark: the most darts active at once, whatever their class
+	UFUNCTION(BlueprintCallable, Category = "Dart Pool")
+	FDartPoolStats GetTotalStats() const;
+
+protected:
+	// Dart classes to pre-warm when the world begins play
+	UPROPERTY(Config)
+	TArray<FSoftClassPath> PrewarmDartClasses;
+
+	UPROPERTY(Config)
+	int32 PrewarmCount;
+
+private:
+	UPROPERTY()
+	TMap<UClass*, FDartPoolBucket> Buckets;
+
+	// Active darts over every class, and their peak - the per-class peaks can happen at different times
+	int32 TotalActiveCount;
+	int32 TotalHighWaterMark;
+
+	ADart* SpawnPooledDart(UClass* DartClass, FDartPoolBucket& Bucket);
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DartProjectileSubsystem.generated.h"
+
+class ADart;
+class ADoodleCharacter;
+class UInstancedStaticMeshComponent;
+
+// Darts of one class: tuning read from the ADart defaults, one instanced mesh, and the in-flight darts
+// as a structure of arrays
+USTRUCT()
+struct FDartProjectileBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UInstancedStaticMeshComponent* Instances = nullptr;
+
+	float Speed = 0.0f;
+	float KnockbackForce = 0.0f;
+	float DotProductThreshold = 0.0f;
+	float Lifetime = 0.0f;
+	float Radius = 0.0f;
+
+	// Collision capsule in the dart's frame: center, unit axis and half length of the axis segment
+	FVector CapsuleCenter = FVector::ZeroVector;
+	FVector CapsuleAxis = FVector::UpVector;
+	float AxisHalfLength = 0.0f;
+	FTransform MeshRelativeTransform;
+
+	TArray<FVector> Origins;
+	TArray<FVector> Directions;
+	TArray<FQuat> Rotations;
+	TArray<float> Speeds;
+	TArray<double> SpawnTimes;
+
+	// Scratch for the per-frame instance update
+	TArray<FTransform> InstanceTransforms;
+
+	int32 Num() const { return Origins.Num(); }
+};
+
+// Darts without one actor per dart. A dart is a record (origin, direction, speed, spawn time) whose position
+// is evaluated in closed form. Every dart of a class is drawn by one instanced mesh, and hits against the player
+// come from one swept test per frame over all darts in the player's moving frame, using the same
+// dot-product rule as ADart: knockback when flying into the player, a platform to bounce on otherwise.
+UCLASS()
+class DOODLEJUMP_API UDartProjectileSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UDartProjectileSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Fire a dart of DartClass from SpawnTransform; like ADart it flies along the transform's right vector.
+	// FlightTime starts it that many seconds into its flight (a shot fired late); nothing is fired past its Lifetime.
+	UFUNCTION(BlueprintCallable, Category = "Dart Projectiles")
+	void FireDart(TSubclassOf<ADart> DartClass, const FTransform& SpawnTransform, float FlightTime = 0.0f);
+
+	UFUNCTION(BlueprintPure, Category = "Dart Projectiles")
+	int32 GetNumDarts() const;
+
+	// Drop every dart in flight (world reset)
+	void ClearDarts();
+
+private:
+	friend class UDoodleCheckpointSubsystem;
+
+	UPROPERTY()
+	TMap<UClass*, FDartProjectileBatch> Batches;
+
+	// Owns the instanced mesh components
+	UPROPERTY()
+	AActor* RenderActor;
+
+	FVector LastPlayerLocation;
+	bool bHasLastPlayerLocation;
+
+	FDartProjectileBatch* FindOrAddBatch(UClass* DartClass);
+	void RemoveDart(FDartProjectileBatch& Batch, int32 Index);
+	void ResolvePlayerHits(FDartProjectileBatch& Batch, ADoodleCharacter* Player, double Time, float DeltaTime);
+	void UpdateInstances(FDartProjectileBatch& Batch, double Time);
+};
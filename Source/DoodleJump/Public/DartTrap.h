@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "DartTrap.generated.h"
+
+class ADart;
+class UStaticMeshComponent;
+class UDartTrapSchedulerSubsystem;
+
+// Fires darts in a fixed pattern: every FireInterval seconds a burst of BurstCount darts, BurstSpacing apart.
+// The trap has no tick and no timer - UDartTrapSchedulerSubsystem fires every trap from one queue.
+// Shot times are fixed on the world clock (PhaseOffset + cycle * FireInterval + shot * BurstSpacing),
+// so traps stay in step with each other however long they were out of range or when they were spawned.
+UCLASS()
+class DOODLEJUMP_API ADartTrap : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ADartTrap();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UStaticMeshComponent* TrapMesh;
+
+	// Darts leave from here
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	USceneComponent* Muzzle;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	TSubclassOf<ADart> DartClass;
+
+	// Seconds between the starts of two bursts
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	float FireInterval;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	int32 BurstCount;
+
+	// Seconds between the darts of one burst
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	float BurstSpacing;
+
+	// Seconds into the world clock of the first burst - traps with the same interval and offset fire together
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	float PhaseOffset;
+
+	// Flight direction relative to the trap
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	FVector FireDirection;
+
+	// Fire through UDartProjectileSubsystem instead of pooled dart actors
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	bool bUseDartRecords;
+
+private:
+	friend class UDartTrapSchedulerSubsystem;
+
+	// Slot in UDartTrapSchedulerSubsystem, INDEX_NONE while not registered
+	int32 SchedulerSlot;
+
+	// Entry in UDoodleHeightIndexSubsystem for traps placed in the level
+	int32 HeightIndexHandle;
+
+	// Called by UDartTrapSchedulerSubsystem when a shot is due and the trap is in range, Lateness seconds after its time
+	void Fire(float Lateness);
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DartTrapSchedulerSubsystem.generated.h"
+
+class ADartTrap;
+
+// Fires every ADartTrap from one queue of upcoming shots, ordered by time.
+// Each frame pops the shots that are due in time order, fires the traps close enough to the player
+// and queues each trap's next shot. Traps out of range still advance through their pattern without firing,
+// so they are in phase again the moment they come back in range. Shots that came due during a long frame are fired
+// as far along their path as they would be by now, so a hitch does not stack a trap's darts at its muzzle.
+UCLASS(Config = Game)
+class DOODLEJUMP_API UDartTrapSchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UDartTrapSchedulerSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterTrap(ADartTrap* Trap);
+	void UnregisterTrap(ADartTrap* Trap);
+
+	int32 GetNumTraps() const { return Slots.Num() - FreeSlots.Num(); }
+
+protected:
+	// Traps further than this above or below the player do not fire
+	UPROPERTY(Config)
+	float FireDistance;
+
+	// Shortest FireInterval accepted, so a misconfigured trap cannot flood the queue
+	UPROPERTY(Config)
+	float MinFireInterval;
+
+private:
+	struct FSlot
+	{
+		ADartTrap* Trap = nullptr;
+		int64 Cycle = 0;
+		int32 Shot = 0;
+		// Tells queued shots of a trap that has since left the slot apart from current ones
+		uint32 Serial = 0;
+	};
+
+	struct FQueuedShot
+	{
+		double Time;
+		int32 Slot;
+		uint32 Serial;
+	};
+
+	TArray<FSlot> Slots;
+	TArray<int32> FreeSlots;
+
+	// Min-heap on time, ties broken by slot so the firing order does not depend on insertion order
+	TArray<FQueuedShot> Queue;
+
+	uint32 NextSerial;
+
+	void QueueShot(int32 SlotIndex);
+	double GetShotTime(const FSlot& Slot) const;
+};
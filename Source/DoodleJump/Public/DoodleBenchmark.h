@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Per-class tick timings collected while a benchmark run is recording.
+// Game thread only - worker-thread code must not open a scope.
+struct DOODLEJUMP_API FDoodleBenchmarkTickTimings
+{
+	struct FEntry
+	{
+		uint64 Cycles = 0;
+		int32 Calls = 0;
+	};
+
+	static bool bIsRecording;
+	static TMap<FName, FEntry> Entries;
+
+	static void Reset() { Entries.Reset(); }
+};
+
+struct FDoodleBenchmarkTickScope
+{
+	explicit FDoodleBenchmarkTickScope(FName InName)
+		: Name(InName)
+		, StartCycles(FDoodleBenchmarkTickTimings::bIsRecording ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FDoodleBenchmarkTickScope()
+	{
+		if (StartCycles != 0 && FDoodleBenchmarkTickTimings::bIsRecording)
+		{
+			FDoodleBenchmarkTickTimings::FEntry& Entry = FDoodleBenchmarkTickTimings::Entries.FindOrAdd(Name);
+			Entry.Cycles += FPlatformTime::Cycles64() - StartCycles;
+			Entry.Calls++;
+		}
+	}
+
+private:
+	FName Name;
+	uint64 StartCycles;
+};
+
+// Times the enclosing scope under Name in the benchmark report. Costs one bool check when not recording.
+#define DOODLE_BENCHMARK_TICK_SCOPE(Name) \
+	static const FName PREPROCESSOR_JOIN(DoodleBenchmarkName, __LINE__)(TEXT(Name)); \
+	FDoodleBenchmarkTickScope PREPROCESSOR_JOIN(DoodleBenchmarkScope, __LINE__)(PREPROCESSOR_JOIN(DoodleBenchmarkName, __LINE__))
+
+// Input-to-motion latency collected while a benchmark run is recording. Game thread only.
+// A Move event is stamped when Enhanced Input dispatches it and closed by the first movement step that applies it.
+// The frame start is the world tick start, just after the platform pumped that frame's input.
+struct DOODLEJUMP_API FDoodleInputLatencyProbe
+{
+	static uint64 FrameStartCycles;
+	static TArray<float> EventToMotionMs;
+	static TArray<float> FrameToMotionMs;
+	// Events applied in a later frame than the one that sampled them
+	static int32 LateEvents;
+
+	static void MarkFrameStart();
+	static void MarkInputEvent();
+	static void MarkMotion();
+	static void Reset();
+
+private:
+	static uint64 EventCycles;
+	static uint64 EventFrameStartCycles;
+	static uint64 EventFrame;
+};
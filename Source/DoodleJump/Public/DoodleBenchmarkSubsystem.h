@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DoodleBenchmarkSubsystem.generated.h"
+
+class ADoodleCharacter;
+
+// One step of the scripted input track: hold Move at Value for Duration seconds
+USTRUCT()
+struct FDoodleBenchmarkInputStep
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Config)
+	float Duration = 1.0f;
+
+	UPROPERTY(Config)
+	FVector2D Value = FVector2D::ZeroVector;
+};
+
+// Headless gameplay benchmark. Only created when the game runs with -DoodleBench, e.g.
+//   UnrealEditor DoodleJump.uproject /Game/Maps/First -game -nullrhi -unattended -DoodleBench -BenchDuration=60 -BenchStress=4
+// Drives the player with a scripted input track, records game-thread frame times and per-class tick times,
+// writes a JSON report plus a row in a cumulative CSV under Saved/Benchmarks and then exits.
+UCLASS(Config = Game)
+class DOODLEJUMP_API UDoodleBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UDoodleBenchmarkSubsystem();
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	// Seconds measured after warm-up (-BenchDuration=)
+	UPROPERTY(Config)
+	float Duration;
+
+	// Seconds ignored at the start of the run (-BenchWarmup=)
+	UPROPERTY(Config)
+	float WarmupDuration;
+
+	// Copies made of each moving and breakable platform, and multiplier for the dart stream (-BenchStress=)
+	UPROPERTY(Config)
+	int32 StressMultiplier;
+
+	// Horizontal distance between stress copies
+	UPROPERTY(Config)
+	float StressSpacing;
+
+	// Breakable platform classes (besides ABreakablePlatform) multiplied in stress mode
+	UPROPERTY(Config)
+	TArray<FSoftClassPath> StressBreakableClasses;
+
+	// Dart class fired around the player in stress mode, DartsPerSecond per stress level
+	UPROPERTY(Config)
+	FSoftClassPath StressDartClass;
+
+	UPROPERTY(Config)
+	float DartsPerSecond;
+
+	// Looped Move input (-BenchInput= loads "duration,x,y" lines from a file instead)
+	UPROPERTY(Config)
+	TArray<FDoodleBenchmarkInputStep> InputTrack;
+
+	// Seconds between in-place restarts (UDoodleWorldResetSubsystem) during the measured window, 0 for none (-BenchRestartEvery=)
+	UPROPERTY(Config)
+	float RestartInterval;
+
+	// Request engine exit after writing the report
+	UPROPERTY(Config)
+	bool bExitWhenDone;
+
+private:
+	FString OutputDirectory;
+	bool bCaptureCsv;
+	bool bUseDartRecords;
+	double RunTime;
+	bool bFinished;
+
+	int32 InputStepIndex;
+	float InputStepTime;
+	float DartSpawnAccumulator;
+	FRandomStream StressRandom;
+
+	uint64 WorldTickStartCycles;
+	uint64 LastTickEndCycles;
+	TArray<float> GameThreadFrameTimes;
+	TArray<float> FrameTimes;
+
+	float RestartAccumulator;
+	uint64 RestartFrame;
+	TArray<float> ResetTimes;
+	TArray<float> RestartTimes;
+
+	FDelegateHandle TickStartHandle;
+	FDelegateHandle TickEndHandle;
+
+	UPROPERTY()
+	UClass* LoadedDartClass;
+
+	void ParseCommandLine();
+	void LoadInputTrack(const FString& FilePath);
+	void ApplyStress();
+	void DriveInput(ADoodleCharacter* Character, float DeltaTime);
+	void SpawnStressDarts(ADoodleCharacter* Character, float DeltaTime);
+	void MeasureRestarts(float DeltaTime);
+	void WriteReport();
+
+	void HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void HandleWorldTickEnd(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+};
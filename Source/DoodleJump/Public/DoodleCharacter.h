@@ -8,6 +8,8 @@ class USpringArmComponent;
 class UCameraComponent;
 class UInputMappingContext;
 class UInputAction;
+class UDoodleMovementComponent;
+class UDoodleGhostRecorderComponent;
 struct FInputActionValue;
 
 UCLASS()
@@ -16,7 +18,7 @@ class DOODLEJUMP_API ADoodleCharacter : public ACharacter
 	GENERATED_BODY()
 
 public:
-	ADoodleCharacter();
+	ADoodleCharacter(const FObjectInitializer& ObjectInitializer);
 
 	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
@@ -30,8 +32,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Movement")
 	void ApplyKnockback(FVector Direction, float Force);
 
+	UFUNCTION(BlueprintPure, Category = "Movement")
+	UDoodleMovementComponent* GetDoodleMovement() const { return DoodleMovement; }
+
+	UInputAction* GetMoveAction() const { return MoveAction; }
+	UInputAction* GetLookAction() const { return LookAction; }
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	USpringArmComponent* SpringArm;
@@ -39,6 +48,9 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	UCameraComponent* Camera;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UDoodleGhostRecorderComponent* GhostRecorder;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Main Settings")
 	UInputMappingContext* InputMappingContext;
 
@@ -82,24 +94,19 @@ protected:
 	float DefaultFreezeDuration;
 
 private:
+	friend class UDoodleSimulationSubsystem;
+
 	void Move(const FInputActionValue& Value);
-	void ClearMovementInput(const FInputActionValue& Value);
 	void Look(const FInputActionValue& Value);
-	void AutoJump();
 	void AutoRotate(float DeltaTime);
-	void ManualMovement(float DeltaTime);
 
-	bool bIsFrozen;
-	FTimerHandle FreezeTimerHandle;
-	AActor* FreezeAttachmentActor;
-	FVector FreezeRelativeOffset;  // Store offset from attachment actor
-	void UnfreezeCharacter();
+	// World reset: back to where BeginPlay found the character
+	void ResetCharacter();
 
-	// Knockback state
-	bool bIsKnockedBack;
-	FTimerHandle KnockbackTimerHandle;
-	void EndKnockback();
+	FTransform InitialTransform;
+	FRotator InitialControlRotation;
+	FRotator InitialMeshRotation;
 
-	// Manual movement input storage
-	FVector2D CurrentMovementInput;
+	UPROPERTY()
+	UDoodleMovementComponent* DoodleMovement;
 };
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "DoodleCheckpointSubsystem.generated.h"
+
+class ADoodleCharacter;
+
+// Snapshot of the gameplay state, restored in place within one frame. Object references go through a side
+// table so the byte stream stays flat; positions and times are stored as floats, timers relative to the capture.
+struct FDoodleCheckpoint
+{
+	TArray<uint8> Data;
+	TArray<TWeakObjectPtr<UObject>> References;
+
+	bool IsValid() const { return Data.Num() > 0; }
+	int32 GetSizeBytes() const { return Data.Num() + References.Num() * sizeof(TWeakObjectPtr<UObject>); }
+};
+
+// Writes the actor's state when the archive is saving and reads it back when it is loading
+DECLARE_DELEGATE_OneParam(FDoodleCheckpointDelegate, FArchive&);
+
+// Checkpoint and respawn for long runs and practice mode. SaveCheckpoint captures the characters (transform,
+// velocity, control rotation, freeze/knockback with remaining time and freeze attachment), moving platform path
+// phases, broken platforms, the endless tower's chunk window and live darts and dart records into a buffer reserved
+// up front, along with whatever registered actors (rising lava) write; RestoreCheckpoint puts all of it back. `doodle.SaveCheckpoint` / `doodle.LoadCheckpoint` do the same from the console.
+UCLASS(Config = Game)
+class DOODLEJUMP_API UDoodleCheckpointSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UDoodleCheckpointSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Actors with state of their own call this from BeginPlay. Each one's data is sized, so an actor that is gone
+	// at restore is skipped.
+	void RegisterCheckpointed(AActor* Actor, FDoodleCheckpointDelegate OnSerialize);
+	void UnregisterCheckpointed(AActor* Actor);
+
+	UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+	void SaveCheckpoint();
+
+	// Returns false if there is no checkpoint or it is unreadable
+	UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+	bool RestoreCheckpoint();
+
+	UFUNCTION(BlueprintPure, Category = "Checkpoint")
+	bool HasCheckpoint() const { return Checkpoint.IsValid(); }
+
+	UFUNCTION(BlueprintPure, Category = "Checkpoint")
+	int32 GetCheckpointBytes() const { return Checkpoint.GetSizeBytes(); }
+
+	UFUNCTION(BlueprintPure, Category = "Checkpoint")
+	float GetLastCaptureMs() const { return LastCaptureMs; }
+
+	UFUNCTION(BlueprintPure, Category = "Checkpoint")
+	float GetLastRestoreMs() const { return LastRestoreMs; }
+
+protected:
+	// Reserved for the snapshot when the world starts; larger snapshots still work but reallocate
+	UPROPERTY(Config)
+	int32 ReserveBytes;
+
+	UPROPERTY(Config)
+	int32 ReserveReferences;
+
+private:
+	FDoodleCheckpoint Checkpoint;
+
+	TMap<TObjectKey<AActor>, FDoodleCheckpointDelegate> Checkpointed;
+
+	float LastCaptureMs;
+	float LastRestoreMs;
+
+	void SaveCharacters(FArchive& Ar);
+	void SaveMovingPlatforms(FArchive& Ar);
+	void SaveBreakablePlatforms(FArchive& Ar);
+	void SaveTowerGenerators(FArchive& Ar);
+	void SaveDarts(FArchive& Ar);
+	void SaveCheckpointed(FArchive& Ar);
+
+	void RestoreCharacters(FArchive& Ar);
+	void RestoreMovingPlatforms(FArchive& Ar);
+	void RestoreBreakablePlatforms(FArchive& Ar);
+	void RestoreTowerGenerators(FArchive& Ar);
+	void RestoreDarts(FArchive& Ar);
+	void RestoreCheckpointed(FArchive& Ar);
+
+	int32 AddReference(UObject* Object);
+
+	template<typename T>
+	T* ResolveReference(int32 Index) const
+	{
+		return Checkpoint.References.IsValidIndex(Index) ? Cast<T>(Checkpoint.References[Index].Get()) : nullptr;
+	}
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "DoodleContactSubsystem.generated.h"
+
+class ADoodleCharacter;
+class UPrimitiveComponent;
+
+// Which face of the hazard the character touched
+enum class EDoodleContactSide : uint8
+{
+	Top,
+	Side,
+	Bottom,
+};
+
+// One (hazard, character) contact, classified once per frame
+struct FDoodleContact
+{
+	ADoodleCharacter* Character = nullptr;
+	UPrimitiveComponent* HazardComponent = nullptr;
+
+	// Contact normal pointing from the hazard towards the character
+	FVector Normal = FVector::UpVector;
+	FVector ImpactPoint = FVector::ZeroVector;
+
+	// Unit direction from the hazard actor to the character
+	FVector ToCharacter = FVector::ZeroVector;
+	FVector CharacterVelocity = FVector::ZeroVector;
+
+	EDoodleContactSide Side = EDoodleContactSide::Side;
+
+	// Raw hit callbacks folded into this contact
+	int32 NumHits = 0;
+};
+
+DECLARE_DELEGATE_OneParam(FDoodleContactDelegate, const FDoodleContact&);
+
+// Collects blocking hits on registered hazard components (ADoodlePlatformBase platforms, darts) and hands each
+// hazard one classified contact per character per frame, instead of running hazard logic on every
+// physics callback. Hazards use the DoodleHazard collision profile, which only blocks pawns and traces,
+// so nothing but the player produces hit events for them in the first place.
+UCLASS()
+class DOODLEJUMP_API UDoodleContactSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterHazard(UPrimitiveComponent* Component, FDoodleContactDelegate OnContact);
+	void UnregisterHazard(UPrimitiveComponent* Component);
+
+	// Forget the hits gathered this frame (world reset)
+	void ClearPendingContacts() { PendingContacts.Reset(); }
+
+private:
+	struct FPendingContact
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Hazard;
+		TWeakObjectPtr<ADoodleCharacter> Character;
+		FHitResult Hit;
+		int32 NumHits;
+	};
+
+	TMap<TObjectKey<UPrimitiveComponent>, FDoodleContactDelegate> Hazards;
+
+	// Contacts gathered since the last Tick, one per pair
+	TArray<FPendingContact> PendingContacts;
+	TArray<FPendingContact> DispatchingContacts;
+
+	UFUNCTION()
+	void HandleComponentHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+
+	static FDoodleContact Classify(UPrimitiveComponent* HazardComponent, ADoodleCharacter* Character, const FHitResult& Hit);
+};
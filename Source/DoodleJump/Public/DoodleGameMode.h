@@ -4,6 +4,9 @@
 #include "GameFramework/GameModeBase.h"
 #include "DoodleGameMode.generated.h"
 
+class ADoodleTowerGenerator;
+class ADoodleGhost;
+
 UCLASS()
 class DOODLEJUMP_API ADoodleGameMode : public AGameModeBase
 {
@@ -11,4 +14,19 @@ class DOODLEJUMP_API ADoodleGameMode : public AGameModeBase
 
 public:
 	ADoodleGameMode();
+
+	virtual void StartPlay() override;
+
+protected:
+	// Spawned under the player start when the map is opened with ?Endless
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	TSubclassOf<ADoodleTowerGenerator> EndlessTowerGeneratorClass;
+
+	// Height of the start platform below the player start
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	float EndlessStartDrop;
+
+	// Spawned to replay Saved/Ghosts/<name>.ghost when the map is opened with ?Ghost=<name>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	TSubclassOf<ADoodleGhost> GhostClass;
 };
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "DoodleGhostFormat.h"
+#include "DoodleGhost.generated.h"
+
+class UStaticMeshComponent;
+
+// Plays back a run recorded by UDoodleGhostRecorderComponent. The file is streamed through the engine's buffered
+// file reader and decoded one sample at a time, so playback does not allocate after Play.
+UCLASS()
+class DOODLEJUMP_API ADoodleGhost : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ADoodleGhost();
+
+	virtual void Tick(float DeltaTime) override;
+
+	// Opens Saved/Ghosts/<GhostName>.ghost and starts from its first sample
+	UFUNCTION(BlueprintCallable, Category = "Ghost")
+	bool Play(const FString& InGhostName);
+
+	UFUNCTION(BlueprintCallable, Category = "Ghost")
+	void Stop();
+
+	UFUNCTION(BlueprintPure, Category = "Ghost")
+	bool IsPlaying() const { return Reader.IsValid(); }
+
+	// Recorded state at the current sample, for the Blueprint to drive effects from
+	UFUNCTION(BlueprintPure, Category = "Ghost")
+	bool IsFrozen() const { return (Track.State & DoodleGhost::Frozen) != 0; }
+
+	UFUNCTION(BlueprintPure, Category = "Ghost")
+	bool IsKnockedBack() const { return (Track.State & DoodleGhost::KnockedBack) != 0; }
+
+	UFUNCTION(BlueprintPure, Category = "Ghost")
+	bool IsBoosted() const { return (Track.State & DoodleGhost::Boosted) != 0; }
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ghost")
+	FString GhostName;
+
+	// Start over from the first sample at the end of the run instead of hiding
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ghost")
+	bool bLoop;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UStaticMeshComponent* GhostMesh;
+
+private:
+	TUniquePtr<FArchive> Reader;
+	int64 DataOffset;
+	uint32 NumSamples;
+
+	DoodleGhost::FTrack Track;
+	uint32 SkipRemaining;
+	uint8 PendingFlags;
+	float SampleTime;
+
+	FVector PreviousLocation;
+	FVector CurrentLocation;
+	float PreviousYaw;
+	float CurrentYaw;
+
+	void Rewind();
+
+	// World reset: start the run over
+	void ResetGhost();
+	bool AdvanceSample();
+	bool ReadRecordHeader();
+	bool ReadByte(uint8& Byte);
+	bool ReadVarInt(uint32& Value);
+	bool ReadSigned(int32& Value);
+};
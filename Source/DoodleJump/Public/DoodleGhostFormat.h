@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Ghost trajectory stream (.ghost), written by UDoodleGhostRecorderComponent and played back by ADoodleGhost.
+//
+// Header: magic, version, sample rate, gravity, sample count, map name. Then one record per sample that does not
+// match the prediction, each preceded by the number of predicted samples it skips:
+//   varint Skip, uint8 Flags, payload in flag order
+// Prediction: XY keeps the last step (the movement has no inertia, so held input repeats it), Z follows the
+// ballistic arc started at the last bounce, yaw and state stay. A player holding a direction mid-air costs nothing;
+// a bounce costs a few bytes to start a new arc.
+namespace DoodleGhost
+{
+	static constexpr uint32 FileMagic = 0x54534744; // "DGST"
+	static constexpr uint16 FileVersion = 1;
+
+	// Positions in 2 cm units, arc velocities in 4 cm/s units
+	static constexpr double PositionUnit = 2.0;
+	static constexpr double VelocityUnit = 4.0;
+
+	// Prediction errors up to these many units are not corrected - the encoder tracks the decoded state, so they never accumulate
+	static constexpr int32 XYTolerance = 1;
+	static constexpr int32 ZTolerance = 4;
+
+	// A full keyframe every this many samples bounds the damage of a corrupt record
+	static constexpr int32 KeyframeInterval = 200;
+
+	enum EStateFlags : uint8
+	{
+		Frozen = 1 << 0,
+		KnockedBack = 1 << 1,
+		// Rising faster than a normal bounce - a jump boost
+		Boosted = 1 << 2,
+	};
+
+	enum ERecordFlags : uint8
+	{
+		// Zero flags terminate the stream
+		RecordEnd = 0,
+		RecordXY = 1 << 0,
+		RecordArc = 1 << 1,
+		RecordYaw = 1 << 2,
+		RecordState = 1 << 3,
+		RecordKeyframe = 1 << 4,
+	};
+
+	// Quantized sample as the recorder sees it
+	struct FSample
+	{
+		FIntVector Position = FIntVector::ZeroValue;
+		int32 VelocityZ = 0;
+		uint8 Yaw = 0;
+		uint8 State = 0;
+	};
+
+	// Decoded trajectory state. The recorder runs the same state machine to predict what playback will see.
+	struct FTrack
+	{
+		FIntVector Position = FIntVector::ZeroValue;
+		FIntPoint Step = FIntPoint::ZeroValue;
+		int32 ArcZ = 0;
+		int32 ArcVelocity = 0;
+		int32 ArcSamples = 0;
+		uint8 Yaw = 0;
+		uint8 State = 0;
+
+		// Set up by the header
+		double SampleInterval = 0.1;
+		double GravityZ = 0.0;
+
+		// Arc height after Samples samples (fractional for playback), in position units
+		double ArcHeight(double Samples) const;
+
+		// Advance one sample by prediction only
+		void Predict();
+
+		// Advance one sample and apply a record's payload on top of the prediction
+		void ApplyXY(const FIntPoint& Correction);
+		void StartArc(int32 Z, int32 Velocity);
+		void ApplyKeyframe(const FSample& Sample);
+
+		FVector GetLocation() const { return FVector(Position) * PositionUnit; }
+	};
+
+	void WriteVarInt(TArray<uint8>& Out, uint32 Value);
+	inline uint32 ZigZag(int32 Value) { return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31); }
+	inline int32 UnZigZag(uint32 Value) { return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1); }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "DoodleGhostFormat.h"
+#include "DoodleGhostRecorderComponent.generated.h"
+
+class ADoodleCharacter;
+
+// Records the owning ADoodleCharacter's run as a ghost trajectory (see DoodleGhostFormat.h). Samples are taken on a
+// fixed time step, interpolated between the frames around each sample time, so the rate does not depend on the frame rate.
+// Idle until StartRecording, or from BeginPlay with -RecordGhost=<name>; the run is saved to Saved/Ghosts/<name>.ghost
+// by StopRecording or when the character ends play.
+UCLASS()
+class DOODLEJUMP_API UDoodleGhostRecorderComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UDoodleGhostRecorderComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	UFUNCTION(BlueprintCallable, Category = "Ghost")
+	void StartRecording(const FString& GhostName);
+
+	// Writes the file; returns false if nothing was being recorded or the write failed
+	UFUNCTION(BlueprintCallable, Category = "Ghost")
+	bool StopRecording();
+
+	UFUNCTION(BlueprintPure, Category = "Ghost")
+	bool IsRecording() const { return bRecording; }
+
+	static FString GetGhostPath(const FString& GhostName);
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Trajectory samples per second
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ghost")
+	int32 SampleRate;
+
+private:
+	bool bRecording;
+	FString RecordingName;
+
+	uint32 NumSamples;
+	uint32 PendingSkip;
+	float SampleAccumulator;
+	double RecordingStartTime;
+
+	// Character at the end of the previous and the current frame, with the velocity on the exact parabola
+	FVector PreviousLocation;
+	FVector CurrentLocation;
+	double PreviousVelocityZ;
+	double CurrentVelocityZ;
+	float PreviousYaw;
+	float CurrentYaw;
+
+	DoodleGhost::FTrack Track;
+	TArray<uint8> Stream;
+
+	void CaptureFrame(const ADoodleCharacter* Character, float DeltaTime);
+
+	// Alpha places the sample between the previous (0) and the current (1) frame
+	void RecordSample(const ADoodleCharacter* Character, float Alpha);
+	DoodleGhost::FSample Capture(const ADoodleCharacter* Character, float Alpha) const;
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DoodleHeightIndexSubsystem.generated.h"
+
+// What an index entry is, as a bit so queries can ask for several at once
+enum EDoodleHeightCategory : uint8
+{
+	DHC_Platform = 1 << 0,
+	DHC_Trap = 1 << 1,
+	DHC_Dart = 1 << 2,
+
+	DHC_All = DHC_Platform | DHC_Trap | DHC_Dart,
+};
+
+// Every platform, trap and dart bucketed by height, for "what is near this height" questions
+// (what to tick, what to recycle, where the next landing is, what the camera should frame) without iterating actors.
+// Entries are axis-aligned boxes kept in structure-of-arrays form and filed by the height of their center into
+// fixed-height buckets. Entries added with bMoves follow their actor: the index re-reads their location once per
+// frame, after actors and tickable subsystems (the moving platform batch) have run, and only touches buckets when
+// one is crossed.
+UCLASS(Config = Game)
+class DOODLEJUMP_API UDoodleHeightIndexSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UDoodleHeightIndexSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Index Actor by its colliding bounds. Returns a handle that stays valid until Remove.
+	int32 AddActor(AActor* Actor, EDoodleHeightCategory Category, bool bMoves);
+
+	// Index a part of Owner (e.g. one instance of a platform field) by explicit world bounds. Item is up to the owner.
+	int32 AddBounds(AActor* Owner, int32 Item, const FBox& Bounds, EDoodleHeightCategory Category);
+
+	// Re-read an entry's bounds after its actor was teleported (entries added with bMoves do this by themselves)
+	void Refresh(int32 Handle);
+
+	// Handle is reset to INDEX_NONE
+	void Remove(int32& Handle);
+
+	// Calls Visit(Handle) for every entry of the given categories whose vertical extent overlaps [MinZ, MaxZ]
+	template<typename FunctionType>
+	void ForEachInRange(double MinZ, double MaxZ, uint8 CategoryMask, FunctionType&& Visit) const;
+
+	// Entry of the given categories with the highest top at or below Point whose footprint is within Radius
+	// of Point on XY, searching down to MaxDrop below Point. INDEX_NONE if there is none.
+	int32 FindNearestBelow(const FVector& Point, float Radius, float MaxDrop, uint8 CategoryMask) const;
+
+	AActor* GetActor(int32 Handle) const { return Actors.IsValidIndex(Handle) ? Actors[Handle].Get() : nullptr; }
+	int32 GetItem(int32 Handle) const { return Items.IsValidIndex(Handle) ? Items[Handle] : INDEX_NONE; }
+	FBox GetBounds(int32 Handle) const;
+	int32 GetNumEntries() const { return Categories.Num() - FreeHandles.Num(); }
+
+protected:
+	// Height covered by one bucket. About one jump keeps a landing query to a couple of buckets.
+	UPROPERTY(Config)
+	float BucketHeight;
+
+private:
+	// Per entry, indexed by handle. Category 0 marks a free slot.
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	TArray<int32> Items;
+	TArray<uint8> Categories;
+	TArray<FVector3f> Centers;
+	TArray<FVector3f> Extents;
+	TArray<int32> BucketOf;
+	TArray<int32> BucketSlots;
+
+	// Moving entries: center minus actor location, and the slot in MovingHandles
+	TArray<FVector3f> ActorOffsets;
+	TArray<int32> MovingSlots;
+
+	TArray<int32> MovingHandles;
+	TArray<int32> FreeHandles;
+
+	// Handles per bucket; Buckets[0] is bucket number FirstBucket
+	TArray<TArray<int32>> Buckets;
+	int32 FirstBucket;
+
+	// Largest half height of any entry - how far an entry reaches out of its bucket
+	float MaxHalfHeight;
+
+	FDelegateHandle PostActorTickHandle;
+
+	int32 AllocateHandle();
+	int32 BucketNumber(double Z) const { return FMath::FloorToInt32(Z / BucketHeight); }
+	void InsertIntoBucket(int32 Handle);
+	void RemoveFromBucket(int32 Handle);
+	void SetCenter(int32 Handle, const FVector3f& Center);
+
+	void HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+};
+
+template<typename FunctionType>
+void UDoodleHeightIndexSubsystem::ForEachInRange(double MinZ, double MaxZ, uint8 CategoryMask, FunctionType&& Visit) const
+{
+	if (Buckets.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 First = FMath::Max(BucketNumber(MinZ - MaxHalfHeight) - FirstBucket, 0);
+	const int32 Last = FMath::Min(BucketNumber(MaxZ + MaxHalfHeight) - FirstBucket, Buckets.Num() - 1);
+	for (int32 Bucket = First; Bucket <= Last; ++Bucket)
+	{
+		for (const int32 Handle : Buckets[Bucket])
+		{
+			const float CenterZ = Centers[Handle].Z;
+			const float HalfHeight = Extents[Handle].Z;
+			if ((Categories[Handle] & CategoryMask) && CenterZ + HalfHeight >= MinZ && CenterZ - HalfHeight <= MaxZ)
+			{
+				Visit(Handle);
+			}
+		}
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "DoodleMovementComponent.generated.h"
+
+UENUM(BlueprintType)
+enum ECustomMovementMode
+{
+	CMOVE_None UMETA(Hidden),
+	CMOVE_Doodle UMETA(DisplayName = "Doodle"),
+};
+
+UENUM(BlueprintType)
+enum class EDoodleMovementState : uint8
+{
+	Normal,
+	Frozen,
+	KnockedBack,
+};
+
+// Character movement for the doodle: direct horizontal input, gravity and automatic bounce
+// combined into a single sweep per frame. Freeze and knockback are movement states with their own timers.
+UCLASS()
+class DOODLEJUMP_API UDoodleMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	UDoodleMovementComponent();
+
+	virtual void SetDefaultMovementMode() override;
+	virtual void StartNewPhysics(float DeltaTime, int32 Iterations) override;
+	virtual bool IsFalling() const override;
+	virtual bool HandlePendingLaunch() override;
+	virtual FVector ConsumeInputVector() override;
+
+	// Move action value (X right, Y forward) for this frame. Turned into a world direction only when the movement
+	// consumes it, after the player controller has applied this frame's look input.
+	void LatchMoveInput(const FVector2D& Value);
+
+	// Launch straight up with JumpZVelocity scaled by Multiplier
+	UFUNCTION(BlueprintCallable, Category = "Doodle Movement")
+	void Bounce(float Multiplier = 1.0f);
+
+	// Stop all movement for Duration seconds, optionally following AttachToActor
+	UFUNCTION(BlueprintCallable, Category = "Doodle Movement")
+	void Freeze(float Duration, AActor* AttachToActor = nullptr);
+
+	// Push the character along Direction, ignoring input for KnockbackDuration
+	UFUNCTION(BlueprintCallable, Category = "Doodle Movement")
+	void Knockback(const FVector& Direction, float Force);
+
+	// Back to plain doodling at rest: no freeze, knockback, pending launch or velocity
+	void ResetDoodleState();
+
+	UFUNCTION(BlueprintPure, Category = "Doodle Movement")
+	EDoodleMovementState GetDoodleState() const { return DoodleState; }
+
+	UFUNCTION(BlueprintPure, Category = "Doodle Movement")
+	bool IsFrozen() const { return DoodleState == EDoodleMovementState::Frozen; }
+
+	UFUNCTION(BlueprintPure, Category = "Doodle Movement")
+	bool IsKnockedBack() const { return DoodleState == EDoodleMovementState::KnockedBack; }
+
+	bool IsDoodling() const { return MovementMode == MOVE_Custom && CustomMovementMode == CMOVE_Doodle; }
+
+	// Time left before the current freeze or knockback ends
+	float GetStateTimeRemaining() const { return StateTimeRemaining; }
+
+	AActor* GetFreezeAttachment() const { return FreezeAttachmentActor; }
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Doodle Movement")
+	float KnockbackDuration;
+
+protected:
+	virtual void PhysCustom(float DeltaTime, int32 Iterations) override;
+
+private:
+	friend class UDoodleCheckpointSubsystem;
+
+	EDoodleMovementState DoodleState;
+	float StateTimeRemaining;
+
+	UPROPERTY()
+	AActor* FreezeAttachmentActor;
+
+	FVector FreezeRelativeOffset;  // Offset from the attachment actor while frozen
+
+	FVector2D LatchedMoveInput;
+	bool bHasLatchedMoveInput;
+	// This tick's ConsumeInputVector returned a non-zero input - the next Normal step is the one that applies it
+	bool bConsumedMoveInput;
+
+	// Frozen onto something a moving platform carries - UMovingPlatformSubsystem moves the character with it
+	bool bFreezeCarried;
+
+	void PhysDoodle(float DeltaTime, int32 Iterations);
+	void UpdateStateTimer(float DeltaTime);
+	void HandleLanding(const FHitResult& Hit);
+	void EndFreeze(bool bLaunch);
+	void StartFreezeCarry();
+	void StopFreezeCarry();
+};
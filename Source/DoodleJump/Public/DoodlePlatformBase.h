@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "DoodleHeightIndexSubsystem.h"
+#include "DoodlePlatformBase.generated.h"
+
+class UDoodlePlatformTuning;
+struct FDoodleContact;
+
+// Platforms that react to the player without ticking: breakable platforms, launchpads and freeze traps.
+// Subclasses register their colliding components for contacts and get one classified contact per
+// character per frame from UDoodleContactSubsystem in HandleContact. Platforms placed in the level are
+// also reset and height-indexed here; the ones spawned by another actor (the tower generator) by their owner.
+UCLASS(Abstract)
+class DOODLEJUMP_API ADoodlePlatformBase : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ADoodlePlatformBase();
+
+	// Put the platform back into its placed state
+	UFUNCTION(BlueprintCallable, Category = "Platform")
+	virtual void ResetPlatform();
+
+	// Where ResetPlatform puts the platform back, for owners that move it after BeginPlay (the tower generator's pools)
+	virtual void SetHomeTransform(const FTransform& Transform) {}
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Overrides the per-actor tuning properties when set
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	UDoodlePlatformTuning* Tuning;
+
+	// Copy the values of Tuning over the actor's own, before anything else in BeginPlay
+	virtual void ApplyTuning(const UDoodlePlatformTuning& InTuning) {}
+
+	// How the platform is filed in UDoodleHeightIndexSubsystem
+	virtual EDoodleHeightCategory GetHeightCategory() const { return DHC_Platform; }
+
+	// Route the component's hits to HandleContact. Unregistered automatically in EndPlay.
+	void RegisterContactComponent(UPrimitiveComponent* Component);
+
+	virtual void HandleContact(const FDoodleContact& Contact) PURE_VIRTUAL(ADoodlePlatformBase::HandleContact, );
+
+private:
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> ContactComponents;
+
+	// Entry in UDoodleHeightIndexSubsystem for platforms placed in the level
+	int32 HeightIndexHandle;
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "DoodlePlatformField.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+class UStaticMesh;
+
+UENUM(BlueprintType)
+enum class EDoodlePlatformKind : uint8
+{
+	Plain,
+	Launchpad,
+	Trap
+};
+
+USTRUCT(BlueprintType)
+struct FDoodlePlatformFieldType
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	UStaticMesh* Mesh = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	EDoodlePlatformKind Kind = EDoodlePlatformKind::Plain;
+
+	// Launchpad: jump boost multiplier
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	float BoostMultiplier = 2.0f;
+
+	// Trap: freeze duration in seconds
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	float FreezeDuration = 2.0f;
+};
+
+// Static platforms as instances of one hierarchical instanced static mesh per platform type,
+// instead of one actor with its own mesh component per platform.
+// Instances keep per-instance collision; launchpad and trap instances react to landings natively.
+UCLASS()
+class DOODLEJUMP_API ADoodlePlatformField : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ADoodlePlatformField();
+
+	// Add a platform of the given type, returns its instance index within that type
+	UFUNCTION(BlueprintCallable, Category = "Platform Field")
+	int32 AddPlatform(int32 TypeIndex, const FTransform& WorldTransform);
+
+	UFUNCTION(BlueprintPure, Category = "Platform Field")
+	int32 GetNumPlatforms() const;
+
+	// Type of the platform behind a hit on one of the field's components, INDEX_NONE if it is not ours
+	int32 GetPlatformType(const UPrimitiveComponent* Component) const;
+
+	// Platforms are in UDoodleHeightIndexSubsystem with the field as actor and this as item
+	static int32 MakeHeightIndexItem(int32 TypeIndex, int32 InstanceIndex) { return (TypeIndex << 24) | InstanceIndex; }
+	static int32 GetHeightIndexItemType(int32 Item) { return Item >> 24; }
+	static int32 GetHeightIndexItemInstance(int32 Item) { return Item & 0xFFFFFF; }
+
+#if WITH_EDITOR
+	// Replace every plain static mesh actor in the level whose mesh matches a type with an instance,
+	// and log actor and component counts before and after
+	UFUNCTION(CallInEditor, Category = "Platform Field")
+	void ConvertPlacedPlatforms();
+#endif
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	TArray<FDoodlePlatformFieldType> PlatformTypes;
+
+private:
+	// One instanced component per entry in PlatformTypes, created on first use
+	UPROPERTY()
+	TArray<UHierarchicalInstancedStaticMeshComponent*> TypeComponents;
+
+	// Entries in UDoodleHeightIndexSubsystem, one per instance while playing
+	TArray<int32> HeightIndexHandles;
+
+	UHierarchicalInstancedStaticMeshComponent* GetOrCreateTypeComponent(int32 TypeIndex);
+
+	void AddToHeightIndex(int32 TypeIndex, int32 InstanceIndex);
+
+	UFUNCTION()
+	void OnInstanceHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+};
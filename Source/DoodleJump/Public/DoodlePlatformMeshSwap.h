@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class UAnimSequenceBase;
+class USkeletalMeshComponent;
+class UStaticMeshComponent;
+
+// Idle platforms render and collide through a static mesh. The skeletal mesh is hidden, does not tick and
+// has no collision until an animation has to play, so a level of hundreds of platforms pays for bones only
+// on the few that are breaking or triggering. Toggle with doodle.LazyPlatformMeshes to compare.
+struct DOODLEJUMP_API FDoodlePlatformMeshSwap
+{
+	// True when lazy skeletal meshes are enabled and IdleMesh has a mesh to show
+	static bool CanUse(const UStaticMeshComponent* IdleMesh);
+
+	// Static mesh visible with the given collision, skeletal mesh dormant
+	static void SetIdle(USkeletalMeshComponent* SkeletalMesh, UStaticMeshComponent* IdleMesh, ECollisionEnabled::Type CollisionEnabled);
+
+	// Skeletal mesh takes over rendering, animation and collision
+	static void SetAnimated(USkeletalMeshComponent* SkeletalMesh, UStaticMeshComponent* IdleMesh, ECollisionEnabled::Type CollisionEnabled);
+
+	// Play once, as a montage through the anim instance when there is one; returns the play length
+	static float PlayAnimation(USkeletalMeshComponent* SkeletalMesh, UAnimSequenceBase* Animation);
+
+	// Back to the first frame of whatever was playing
+	static void StopAnimation(USkeletalMeshComponent* SkeletalMesh);
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "DoodlePlatformTuning.generated.h"
+
+// Tuning shared by every ADoodlePlatformBase that points at it, so one asset balances breakable platforms,
+// launchpads and freeze traps together. Platforms without one keep their own per-actor values.
+UCLASS(BlueprintType)
+class DOODLEJUMP_API UDoodlePlatformTuning : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UDoodlePlatformTuning();
+
+	// Breakable: seconds between the hit and the break animation
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Breakable")
+	float BreakDelay;
+
+	// Breakable: debris switches to the PhysicsActor profile and lands on the level instead of falling through it
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Breakable")
+	bool bUseBreakPhysics;
+
+	// Launchpad: jump velocity multiplier
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Launchpad")
+	float BoostMultiplier;
+
+	// Freeze trap: seconds the character stays frozen
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Freeze Trap")
+	float FreezeDuration;
+
+	// Freeze trap: frozen characters follow the trap when it moves
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Freeze Trap")
+	bool bAttachFrozenCharacter;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DoodleSignificanceSubsystem.generated.h"
+
+UENUM()
+enum class EDoodleSignificance : uint8
+{
+	// Ticks every frame
+	Full,
+	// Ticks at a reduced interval; the engine passes the accumulated DeltaTime on the next tick
+	Reduced,
+	// Far below the player - not ticking at all
+	Culled
+};
+
+USTRUCT()
+struct FDoodleSignificanceBucket
+{
+	GENERATED_BODY()
+
+	// Upper bound of the vertical distance to the player covered by this bucket
+	UPROPERTY(Config)
+	float MaxVerticalDistance = 0.0f;
+
+	// Tick interval inside this bucket, 0 ticks every frame
+	UPROPERTY(Config)
+	float TickInterval = 0.0f;
+};
+
+// Throttles gameplay actor ticks by vertical distance from the player.
+// Registered actors close to the player tick every frame, distant ones at the bucket's interval,
+// and actors further than CullDistanceBelow under the player stop ticking (or run their OnCulled delegate).
+// Actors under the cull floor (the rising lava, ARisingLava) are culled wherever the player is.
+UCLASS(Config = Game)
+class DOODLEJUMP_API UDoodleSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UDoodleSignificanceSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// OnCulled, when bound, runs instead of disabling the tick - e.g. to recycle the actor.
+	// Registering an already registered actor only updates the delegate.
+	void RegisterActor(AActor* Actor, FSimpleDelegate OnCulled = FSimpleDelegate());
+	void UnregisterActor(AActor* Actor);
+
+	// Significance of something at height Z. Only reads config and the cached player height, safe from worker threads.
+	EDoodleSignificance ClassifyHeight(double Z, float& OutTickInterval) const;
+
+	bool HasViewer() const { return bHasViewer; }
+	double GetViewerHeight() const { return ViewerHeight; }
+
+	// Everything below Z is culled, -UE_BIG_NUMBER for no floor
+	void SetCullFloor(double Z) { CullFloor = Z; }
+	double GetCullFloor() const { return CullFloor; }
+
+protected:
+	// Sorted by MaxVerticalDistance
+	UPROPERTY(Config)
+	TArray<FDoodleSignificanceBucket> Buckets;
+
+	// Tick interval beyond the last bucket
+	UPROPERTY(Config)
+	float DistantTickInterval;
+
+	// Actors this far below the player are culled
+	UPROPERTY(Config)
+	float CullDistanceBelow;
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		// Map key, valid even after the actor is gone
+		const AActor* Key = nullptr;
+		FSimpleDelegate OnCulled;
+		float BaseTickInterval = 0.0f;
+		float TickInterval = 0.0f;
+		EDoodleSignificance Significance = EDoodleSignificance::Full;
+	};
+
+	TArray<FEntry> Entries;
+	TMap<const AActor*, int32> EntryIndices;
+
+	double ViewerHeight;
+	bool bHasViewer;
+	double CullFloor;
+
+	void RemoveEntryAt(int32 Index);
+};
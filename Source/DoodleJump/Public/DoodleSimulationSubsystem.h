@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DoodleSimulationSubsystem.generated.h"
+
+class ADoodleCharacter;
+
+// Move and Look action values of one world tick, quantized so a recording replays bit for bit
+struct FDoodleInputSample
+{
+	enum : uint8
+	{
+		HasMove = 1 << 0,
+		HasLook = 1 << 1,
+	};
+
+	uint8 Flags = 0;
+	int8 MoveX = 0;
+	int8 MoveY = 0;
+	int16 LookX = 0;
+	int16 LookY = 0;
+
+	bool operator==(const FDoodleInputSample& Other) const
+	{
+		return Flags == Other.Flags && MoveX == Other.MoveX && MoveY == Other.MoveY && LookX == Other.LookX && LookY == Other.LookY;
+	}
+};
+
+// Deterministic simulation mode. Advances the world by a fixed step per frame (FApp fixed time step), so
+// movement, platforms, darts and timers see identical DeltaTimes whatever the render rate, and records or
+// replays the player's Move/Look input per tick:
+//   -DoodleFixedStep[=Hz]       fixed step only
+//   -DoodleRecord=<file>        fixed step + write the input stream when the world shuts down
+//   -DoodleReplay=<file>        fixed step at the recorded rate + inject the recorded actions, devices are unmapped
+// Relative paths resolve under Saved/InputRecordings. Replays go through Enhanced Input like the live run did,
+// so modifiers on the input actions themselves (not on the mappings) would apply twice.
+UCLASS(Config = Game)
+class DOODLEJUMP_API UDoodleSimulationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UDoodleSimulationSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	bool IsFixedStep() const { return bFixedStep; }
+	int32 GetFixedStepHz() const { return FixedStepHz; }
+	bool IsRecording() const { return bRecording; }
+	bool IsReplaying() const { return bReplaying; }
+
+	// Called from ADoodleCharacter's input handlers. While recording, quantizes Value to what a replay will inject.
+	void RecordMoveInput(FVector2D& Value);
+	void RecordLookInput(FVector2D& Value);
+
+protected:
+	// Simulation rate for -DoodleFixedStep without a value and for recordings
+	UPROPERTY(Config)
+	int32 FixedStepHz;
+
+	// Always run at the fixed step, not only when asked for on the command line
+	UPROPERTY(Config)
+	bool bAlwaysFixedStep;
+
+private:
+	bool bFixedStep;
+	bool bRecording;
+	bool bReplaying;
+
+	// FApp state to restore on shutdown
+	bool bPreviousUseFixedTimeStep;
+	double PreviousFixedDeltaTime;
+
+	FString RecordingPath;
+	FString MapName;
+	uint32 NumTicks;
+
+	// Recording: run-length encoded samples, the open run is flushed when the input changes
+	FDoodleInputSample FrameSample;
+	FDoodleInputSample RunSample;
+	uint32 RunLength;
+	TArray<uint8> Stream;
+
+	// Replay: decoded one run at a time
+	int32 ReadOffset;
+	uint32 RunRemaining;
+
+	FDelegateHandle TickStartHandle;
+	FDelegateHandle TickEndHandle;
+
+	void EnableFixedStep(int32 StepHz);
+	bool LoadRecording(const FString& FilePath);
+	void SaveRecording();
+
+	void FlushRun();
+	bool ReadNextSample(FDoodleInputSample& OutSample);
+
+	void HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void HandleWorldTickEnd(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	static FString ResolvePath(const FString& FilePath);
+};
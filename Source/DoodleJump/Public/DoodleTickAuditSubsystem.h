@@ -0,0 +1,138 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DoodleTickAuditSubsystem.generated.h"
+
+class UDoodleTickAuditSubsystem;
+
+// Stands in for the tick functions sampled this frame, one per tick group
+struct FDoodleTickAuditFunction : public FTickFunction
+{
+	UDoodleTickAuditSubsystem* Auditor = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+// Finds actors and components that tick without doing anything. Started with -DoodleTickAudit[=Seconds]
+// or "doodle.TickAudit [Seconds]" (0 stops early), e.g.
+//   UnrealEditor DoodleJump.uproject /Game/Maps/First -game -DoodleTickAudit=30
+// Every tick function in the world is counted. Each frame a few of them, round robin, are sampled: the
+// auditor turns their tick off for the frame and runs it itself from its own tick function in the same
+// group, timed and bracketed by a snapshot of the target's transform and reflected plain-data properties.
+// Classes whose sampled ticks never changed either are flagged idle. The ranked report goes to the log and
+// to Saved/TickAudit/<map>-<timestamp>.csv.
+// Pawns, controllers, their components and tick functions with prerequisites are counted but never sampled,
+// so the player's input and movement order is left alone.
+UCLASS(Config = Game)
+class DOODLEJUMP_API UDoodleTickAuditSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UDoodleTickAuditSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	void StartAudit(float InDuration);
+
+	// Writes the report. Also called when the duration runs out or the world goes away.
+	void StopAudit();
+
+	bool IsAuditing() const { return bAuditing; }
+
+protected:
+	// Seconds audited when no duration is given
+	UPROPERTY(Config)
+	float DefaultDuration;
+
+	// Tick functions taken over and measured per frame
+	UPROPERTY(Config)
+	int32 SamplesPerFrame;
+
+	// Sampled ticks a class needs before it can be flagged idle
+	UPROPERTY(Config)
+	int32 MinSamplesToFlag;
+
+	// Seconds between scans for newly spawned actors and components
+	UPROPERTY(Config)
+	float RescanInterval;
+
+private:
+	friend struct FDoodleTickAuditFunction;
+
+	struct FClassStats
+	{
+		UClass* Class = nullptr;
+		bool bComponent = false;
+		int32 Instances = 0;
+		int64 Ticks = 0;
+		int32 SampledTicks = 0;
+		uint64 SampledCycles = 0;
+		int32 MovedSamples = 0;
+		int32 ChangedSamples = 0;
+
+		// Reflected plain-data properties, snapshotted around sampled ticks
+		TArray<const FProperty*> StateProperties;
+	};
+
+	struct FTarget
+	{
+		TWeakObjectPtr<UObject> Object;
+		FTickFunction* TickFunction = nullptr;
+		int32 ClassIndex = INDEX_NONE;
+		float LastTickTime = 0.0f;
+		bool bCanSample = false;
+	};
+
+	struct FSample
+	{
+		int32 TargetIndex;
+		ETickingGroup TickGroup;
+	};
+
+	bool bAuditing;
+	float Duration;
+	double StartTime;
+	double LastScanTime;
+	uint64 NumFrames;
+
+	TArray<FClassStats> Classes;
+	TMap<UClass*, int32> ClassIndices;
+	TArray<FTarget> Targets;
+	TSet<const FTickFunction*> KnownTickFunctions;
+	int32 NextSampleTarget;
+
+	// Taken over this frame
+	TArray<FSample> Samples;
+
+	// Tick functions turned off by the audit. They stay off for the whole frame - enabling one mid-frame makes the
+	// engine tick it as newly spawned - and are handed back at the start of the next world tick, before StartFrame.
+	struct FTakenTick
+	{
+		TWeakObjectPtr<UObject> Object;
+		FTickFunction* TickFunction = nullptr;
+	};
+	TArray<FTakenTick> TakenTicks;
+
+	FDoodleTickAuditFunction GroupFunctions[TG_NewlySpawned];
+
+	FDelegateHandle TickStartHandle;
+
+	void ScanTargets();
+	void AddTarget(UObject* Object, FTickFunction& TickFunction, bool bCanSample);
+	void CountTicks();
+	void PickSamples();
+	void HandBackTicks();
+	void RunSamples(ETickingGroup TickGroup, float DeltaTime, ELevelTick TickType);
+	void WriteReport();
+
+	uint32 SnapshotState(const UObject* Object, const FClassStats& Stats, FTransform& OutTransform) const;
+
+	void HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+};
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "DoodleTowerGenerator.generated.h"
+
+class UStaticMesh;
+
+USTRUCT(BlueprintType)
+struct FDoodleTowerPlatformType
+{
+	GENERATED_BODY()
+
+	// Actor to place (BP_MovingPlatform, BP_BreakPlatform, BP_LaunchPad, BP_Trap, BP_DartTrap, ...)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	TSubclassOf<AActor> PlatformClass;
+
+	// Plain static platform (GreenPlatform) when no PlatformClass is set
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	UStaticMesh* StaticMesh = nullptr;
+
+	// Relative chance among the types allowed at a height
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	float Weight = 1.0f;
+
+	// Not placed below this height above the tower base
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	float MinHeight = 0.0f;
+
+	// Moving platforms travel this far to each side of their spot
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	float MoveDistance = 0.0f;
+
+	// Indexed as a trap rather than a platform in UDoodleHeightIndexSubsystem
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	bool bIsTrap = false;
+};
+
+USTRUCT()
+struct FDoodleTowerChunk
+{
+	GENERATED_BODY()
+
+	int32 Index = INDEX_NONE;
+
+	UPROPERTY()
+	TArray<AActor*> Actors;
+
+	TArray<int32> TypeIndices;
+
+	// Where each actor was placed and its moving platform axis, parallel to Actors
+	TArray<FVector> Locations;
+	TArray<FVector> MoveAxes;
+
+	// Entries in UDoodleHeightIndexSubsystem, parallel to Actors
+	TArray<int32> HeightIndexHandles;
+};
+
+USTRUCT()
+struct FDoodleTowerPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AActor*> FreeActors;
+};
+
+// Endless mode: builds the tower in vertical chunks ahead of the player and recycles chunks behind.
+// Chunk contents come from a stream seeded per chunk, so a tower is the same whatever the frame timing.
+// Placement work is queued and drained within FrameBudgetMs, and recycled actors are reused,
+// so actor count and memory stay flat however high the player climbs.
+UCLASS()
+class DOODLEJUMP_API ADoodleTowerGenerator : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ADoodleTowerGenerator();
+
+	virtual void Tick(float DeltaTime) override;
+
+	int32 GetNumLiveActors() const;
+	int32 GetNumPooledActors() const;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// The first type is also used for the start platform placed at the generator's location
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	TArray<FDoodleTowerPlatformType> PlatformTypes;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	float ChunkHeight;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	int32 PlatformsPerChunk;
+
+	// Platforms are scattered within this half extent around the generator on X and Y
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	float TowerHalfWidth;
+
+	// Chunks kept generated above the player's chunk
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	int32 ChunksAhead;
+
+	// Chunks kept below the player's chunk before they are recycled
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	int32 ChunksBehind;
+
+	// Milliseconds per frame spent placing platforms
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	float FrameBudgetMs;
+
+	// Platforms placed per frame instead of FrameBudgetMs when the simulation runs at a fixed step
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	int32 FixedStepPlacementsPerFrame;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	int32 Seed;
+
+private:
+	friend class UDoodleCheckpointSubsystem;
+
+	struct FPendingPlacement
+	{
+		int32 ChunkIndex;
+		int32 TypeIndex;
+		FVector Location;
+		FVector MoveAxis;
+	};
+
+	// Live chunks, lowest first
+	UPROPERTY()
+	TArray<FDoodleTowerChunk> Chunks;
+
+	// Recycled actors, one pool per entry in PlatformTypes
+	UPROPERTY()
+	TArray<FDoodleTowerPool> Pools;
+
+	TArray<FPendingPlacement> PendingPlacements;
+	int32 PendingHead;
+	int32 NextChunkToPlan;
+
+	void PlanChunk(int32 ChunkIndex);
+	void RecycleChunksBelow(int32 ChunkIndex);
+	void ProcessPendingPlacements();
+	int32 PickPlatformType(FRandomStream& Random, float Height) const;
+
+	AActor* AcquirePlatform(const FPendingPlacement& Placement);
+	void PlacePlatform(AActor* Platform, const FPendingPlacement& Placement);
+	void SetupPlatformPath(AActor* Platform, const FPendingPlacement& Placement) const;
+	void ReleasePlatform(int32 TypeIndex, AActor* Platform);
+
+	// World reset: recycle everything and rebuild the first chunk from the pools
+	void ResetTower();
+
+	// Checkpoint restore: put the saved chunks back in place with the same actors, pool the rest and resume
+	// planning where the checkpoint left off
+	void RestoreChunks(TArray<FDoodleTowerChunk>& InChunks, TArray<FPendingPlacement>& InPendingPlacements, int32 InNextChunkToPlan);
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Gameplay event trace: fixed-size binary ring buffer, formatted only when dumped
+// (doodle.DumpTrace, or automatically on a crash). Compiled out of shipping builds unless DOODLE_TRACE_ENABLED is defined.
+#ifndef DOODLE_TRACE_ENABLED
+#define DOODLE_TRACE_ENABLED !UE_BUILD_SHIPPING
+#endif
+
+enum class EDoodleTraceEvent : uint8
+{
+	PlatformHit,		// Values: hit normal, breaks (0/1)
+	PlatformBreak,		// Values: break delay
+	PlatformFall,		// Values: full physics (0/1), animation length
+	DartHit,			// Values: dot product, threshold, knockback (0/1), projectile index
+	JumpBoost,			// Values: multiplier, velocity Z before, after
+	Freeze,				// Values: duration, relative offset
+	Unfreeze,			// Values: launched (0/1)
+	Knockback,			// Values: direction, force
+	KnockbackEnd,
+	WorldReset,			// Values: reset ms, registered actors
+	LavaKill,			// Values: lava height, feet height
+};
+
+#if DOODLE_TRACE_ENABLED
+struct FDoodleTraceRecord
+{
+	double Time;
+	uint64 Frame;
+	// Names are taken when the event is recorded, so dumping never touches the objects
+	FName Subject;
+	FName Other;
+	float Values[4];
+	EDoodleTraceEvent Event;
+};
+#endif
+
+// Game thread only
+struct DOODLEJUMP_API FDoodleTrace
+{
+#if DOODLE_TRACE_ENABLED
+	static constexpr int32 Capacity = 4096;
+
+	static void Record(EDoodleTraceEvent Event, const UObject* Subject, const UObject* Other = nullptr,
+		float A = 0.0f, float B = 0.0f, float C = 0.0f, float D = 0.0f);
+
+	// Oldest record first
+	static void Dump(FOutputDevice& Ar);
+
+	// Writes Saved/Logs/DoodleTrace-<timestamp>.txt and returns its path
+	static FString DumpToFile();
+
+	// Writes to a path built in advance - what the crash handler uses
+	static void DumpToFile(const TCHAR* FilePath);
+#else
+	static void Record(EDoodleTraceEvent Event, const UObject* Subject, const UObject* Other = nullptr,
+		float A = 0.0f, float B = 0.0f, float C = 0.0f, float D = 0.0f) {}
+#endif
+};
+
+#if DOODLE_TRACE_ENABLED
+#define DOODLE_TRACE(Event, ...) FDoodleTrace::Record(EDoodleTraceEvent::Event, __VA_ARGS__)
+#else
+#define DOODLE_TRACE(Event, ...)
+#endif
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "DoodleWorldResetSubsystem.generated.h"
+
+// Restarts the run in place instead of reloading the map. ResetWorld releases every dart, lets each registered
+// actor restore the state it captured at BeginPlay (character, breakable platforms, tower generator, ghosts),
+// then rewinds the moving platform paths. Nothing is spawned or loaded, so the next frame is playable right away.
+// `doodle.Restart` does the same from the console.
+UCLASS()
+class DOODLEJUMP_API UDoodleWorldResetSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UDoodleWorldResetSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// Actors call this from BeginPlay with the function that puts them back to their initial state
+	void RegisterResettable(AActor* Actor, FSimpleDelegate OnReset);
+	void UnregisterResettable(AActor* Actor);
+
+	UFUNCTION(BlueprintCallable, Category = "World Reset")
+	void ResetWorld();
+
+	// Time spent inside the last ResetWorld
+	UFUNCTION(BlueprintPure, Category = "World Reset")
+	float GetLastResetMs() const { return LastResetMs; }
+
+	// Time from the last ResetWorld call to the end of the first world tick after it
+	UFUNCTION(BlueprintPure, Category = "World Reset")
+	float GetLastRestartMs() const { return LastRestartMs; }
+
+private:
+	TMap<TObjectKey<AActor>, FSimpleDelegate> Resettables;
+
+	// Resetting may unregister actors (expired darts), so the delegates are copied out first
+	TArray<FSimpleDelegate> ResettingDelegates;
+
+	uint64 ResetStartCycles;
+	uint64 ResetFrame;
+	float LastResetMs;
+	float LastRestartMs;
+
+	FDelegateHandle TickEndHandle;
+
+	void HandleWorldTickEnd(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DoodlePlatformBase.h"
+#include "FreezeTrapPlatform.generated.h"
+
+class UAnimSequenceBase;
+class USkeletalMeshComponent;
+class UStaticMeshComponent;
+
+// Landing on top freezes the character for FreezeDuration and plays TriggerAnimation; it bounces off when the freeze ends
+UCLASS()
+class DOODLEJUMP_API AFreezeTrapPlatform : public ADoodlePlatformBase
+{
+	GENERATED_BODY()
+
+public:
+	AFreezeTrapPlatform();
+
+	// Stop the trigger animation and go back to the idle mesh
+	virtual void ResetPlatform() override;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void ApplyTuning(const UDoodlePlatformTuning& InTuning) override;
+	virtual EDoodleHeightCategory GetHeightCategory() const override { return DHC_Trap; }
+	virtual void HandleContact(const FDoodleContact& Contact) override;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	USkeletalMeshComponent* PlatformMesh;
+
+	// Static stand-in for PlatformMesh while no animation plays. Leave its mesh empty to always use the skeletal mesh.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UStaticMeshComponent* IdleMesh;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	float FreezeDuration;
+
+	// Frozen characters follow the trap when it moves (e.g. attached to a moving platform)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	bool bAttachFrozenCharacter;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	UAnimSequenceBase* TriggerAnimation;
+
+private:
+	FTimerHandle AnimationTimerHandle;
+
+	ECollisionEnabled::Type InitialCollisionEnabled;
+
+	// IdleMesh stands in for PlatformMesh between triggers
+	bool bUseIdleMesh;
+
+	void PlayTriggerAnimation();
+};
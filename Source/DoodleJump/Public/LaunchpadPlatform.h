@@ -3,24 +3,50 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "GameFramework/Actor.h"
+#include "DoodlePlatformBase.h"
 #include "LaunchpadPlatform.generated.h"
 
+class UAnimSequenceBase;
+class USkeletalMeshComponent;
+class UStaticMeshComponent;
+
+// Landing on top launches the character with BoostMultiplier times the normal bounce and plays LaunchAnimation
 UCLASS()
-class DOODLEJUMP_API ALaunchpadPlatform : public AActor
+class DOODLEJUMP_API ALaunchpadPlatform : public ADoodlePlatformBase
 {
 	GENERATED_BODY()
-	
-public:	
-	// Sets default values for this actor's properties
+
+public:
 	ALaunchpadPlatform();
 
+	// Stop the launch animation and go back to the idle mesh
+	virtual void ResetPlatform() override;
+
 protected:
-	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void ApplyTuning(const UDoodlePlatformTuning& InTuning) override;
+	virtual void HandleContact(const FDoodleContact& Contact) override;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	USkeletalMeshComponent* PlatformMesh;
+
+	// Static stand-in for PlatformMesh while no animation plays. Leave its mesh empty to always use the skeletal mesh.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UStaticMeshComponent* IdleMesh;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	float BoostMultiplier;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	UAnimSequenceBase* LaunchAnimation;
+
+private:
+	FTimerHandle AnimationTimerHandle;
+
+	ECollisionEnabled::Type InitialCollisionEnabled;
 
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	// IdleMesh stands in for PlatformMesh between launches
+	bool bUseIdleMesh;
 
+	void PlayLaunchAnimation();
 };
@@ -17,10 +17,15 @@ class DOODLEJUMP_API AMovingPlatform : public AActor
 public:
 	AMovingPlatform();
 
-	virtual void Tick(float DeltaTime) override;
+	// Drive the platform along explicit world-space points instead of MovementPoints
+	void SetPathPoints(TConstArrayView<FVector> WorldPoints);
+
+	// World-space positions of the assigned MovementPoints
+	void GetPathPoints(TArray<FVector>& OutPoints) const;
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	UStaticMeshComponent* PlatformMesh;
@@ -38,8 +43,12 @@ protected:
 	TArray<AActor*> AttachedObjects;
 
 private:
-	int32 CurrentPointIndex;
-	bool bMovingForward;
+	friend class UMovingPlatformSubsystem;
+	friend class UDoodleCheckpointSubsystem;
+
+	// Slot in UMovingPlatformSubsystem, INDEX_NONE while not registered
+	int32 ManagerIndex;
 
-	void MoveTowardsTarget(float DeltaTime);
+	// Entry in UDoodleHeightIndexSubsystem for platforms placed in the level
+	int32 HeightIndexHandle;
 };
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MovingPlatformSubsystem.generated.h"
+
+class AMovingPlatform;
+class UDoodleSignificanceSubsystem;
+class UMovingPlatformSubsystem;
+
+// Runs the batched platform update first thing in TG_PrePhysics, so riders can tick after it
+struct FMovingPlatformTickFunction : public FTickFunction
+{
+	UMovingPlatformSubsystem* Subsystem = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+// Advances every AMovingPlatform in a single batched pass.
+// Platform state is kept as a structure of arrays so the update walks contiguous memory
+// instead of dispatching one actor tick per platform.
+// Positions are evaluated in closed form from elapsed time, so they do not depend on frame rate
+// and a platform can skip any number of frames without drifting.
+// The update is a real tick function rather than a tickable object, so anything standing on or attached to a
+// platform can depend on it (AddTickDependency) and always sees the platform where it is this frame.
+// Riders (AddRider) are carried kinematically: teleported with their platform in the same pass, without a sweep.
+UCLASS(Config = Game)
+class DOODLEJUMP_API UMovingPlatformSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UMovingPlatformSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Start driving the platform along Waypoints (world space, at least two points)
+	void RegisterPlatform(AMovingPlatform* Platform, TConstArrayView<FVector> Waypoints, float Speed, bool bLoop);
+	void UnregisterPlatform(AMovingPlatform* Platform);
+
+	// Put every platform back at the start of its path, as if registered now (world reset)
+	void RestartPaths();
+
+	int32 GetNumPlatforms() const { return Platforms.Num(); }
+
+	// Makes the actor's tick and its components' ticks wait for the platform update
+	void AddTickDependency(AActor* Actor);
+	void RemoveTickDependency(AActor* Actor);
+
+	// Carries Rider with the moving platform Attachment is (or is attached to), at AttachmentOffset from Attachment.
+	// Returns false when no registered platform carries Attachment. The rider's owner should depend on the update.
+	bool AddRider(USceneComponent* Rider, const AActor* Attachment, const FVector& AttachmentOffset);
+	void RemoveRider(USceneComponent* Rider);
+
+	// The registered platform that moves Actor - Actor itself or one of its attach parents
+	AMovingPlatform* FindCarrier(const AActor* Actor) const;
+
+	// Position of a registered platform at the given world time
+	FVector EvaluatePlatformLocation(const AMovingPlatform* Platform, double Time) const;
+
+	// Position along a baked path. PathPoints repeats the first point at the end for looping paths.
+	// CumulativeDistances[i] is the path length up to PathPoints[i]. SegmentHint speeds up the lookup
+	// when consecutive queries are close to each other and is updated in place.
+	static FVector EvaluatePath(const FVector* PathPoints, const float* CumulativeDistances, int32 NumPoints,
+		bool bLoop, double TravelDistance, int32& SegmentHint);
+
+protected:
+	// Platform count from which the update is spread across worker threads
+	UPROPERTY(Config)
+	int32 ParallelUpdateThreshold;
+
+private:
+	friend class UDoodleCheckpointSubsystem;
+	friend struct FMovingPlatformTickFunction;
+
+	enum EPlatformFlags : uint8
+	{
+		PF_Loop = 1 << 0,
+		PF_Moved = 1 << 1,
+		PF_Evaluated = 1 << 2,
+	};
+
+	// Structure of arrays, one element per registered platform
+	UPROPERTY()
+	TArray<AMovingPlatform*> Platforms;
+
+	TArray<FVector> Locations;
+	TArray<float> Speeds;
+	TArray<double> StartTimes;
+	TArray<int32> PathStarts;
+	TArray<int32> PathCounts;
+	TArray<int32> SegmentHints;
+	TArray<uint8> Flags;
+	// Earliest time a distant platform is evaluated again, see UDoodleSignificanceSubsystem
+	TArray<double> NextUpdateTimes;
+
+	// Baked path points of every platform packed back to back, with the matching cumulative distances
+	TArray<FVector> PathPoints;
+	TArray<float> CumulativeDistances;
+
+	struct FRider
+	{
+		TWeakObjectPtr<USceneComponent> Component;
+		TWeakObjectPtr<AMovingPlatform> Platform;
+		FVector Offset = FVector::ZeroVector;
+	};
+
+	TArray<FRider> Riders;
+
+	FMovingPlatformTickFunction PlatformTickFunction;
+
+	void UpdatePlatforms(float DeltaTime);
+	void UpdatePlatform(int32 Index, double Time, const UDoodleSignificanceSubsystem* Significance);
+	void ApplyTransforms();
+	void MoveRiders();
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "RisingLava.generated.h"
+
+class UStaticMeshComponent;
+
+// Lava rising from below. Its height is a closed-form function of the time since the run started:
+//   Height = StartHeight + Difficulty * (RiseSpeed * T + RiseAcceleration * T^2 / 2), with the speed capped at MaxRiseSpeed
+// A negative RiseAcceleration slows the rise until the lava stops; it never sinks below where it started.
+// There is no overlap volume - once a frame the player's feet are compared against the height, and touching it
+// restarts the run (UDoodleWorldResetSubsystem). The height is also the cull floor of UDoodleSignificanceSubsystem,
+// so registered actors, moving platforms, dart records, debris and tower chunks under the surface are culled or recycled.
+// Checkpoints keep its height, difficulty and run time (UDoodleCheckpointSubsystem).
+// The surface is a single collision-free plane that moves with the actor.
+UCLASS()
+class DOODLEJUMP_API ARisingLava : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ARisingLava();
+
+	virtual void Tick(float DeltaTime) override;
+
+	UFUNCTION(BlueprintPure, Category = "Lava")
+	float GetLavaHeight() const { return static_cast<float>(LavaHeight); }
+
+	// Height at a world time, e.g. to show how close the lava is
+	UFUNCTION(BlueprintPure, Category = "Lava")
+	float GetLavaHeightAtTime(float WorldTime) const;
+
+	// Changes the difficulty without moving the surface - the lava carries on from its current height
+	UFUNCTION(BlueprintCallable, Category = "Lava")
+	void SetDifficulty(float NewDifficulty);
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UStaticMeshComponent* Surface;
+
+	// Seconds after the run starts before the lava moves
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	float StartDelay;
+
+	// Units per second when the lava starts to rise
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	float RiseSpeed;
+
+	// Units per second squared
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	float RiseAcceleration;
+
+	// Upper bound of the rise speed, before Difficulty. 0 for no limit
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	float MaxRiseSpeed;
+
+	// Scales the whole rise; change it during a run through SetDifficulty
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Main Settings")
+	float Difficulty;
+
+	// The player dies once their feet are this far below the surface
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Main Settings")
+	float KillDepth;
+
+private:
+	// Captured at BeginPlay and restored on world reset
+	double InitialHeight;
+	float InitialDifficulty;
+
+	// Closed-form inputs - SetDifficulty rebases BaseHeight so the surface does not jump
+	double BaseHeight;
+	double RunStartTime;
+
+	double LavaHeight;
+
+	// Distance risen T seconds after StartDelay, before Difficulty
+	double GetRiseDistance(double T) const;
+
+	void UpdateHeight(double Time);
+	void ResetLava();
+	void SerializeCheckpoint(FArchive& Ar);
+};